@@ -6,7 +6,9 @@ BEGIN_REFLECTION(QMonster)
     // Since it's a body of Monster's private static member function(_RegisterProperties)
     // it's accessible to private
     QFIELD(Level)
-    QFIELD(Rage)
+    QFIELD_RANGE(Rage, 0.0, 1.0, 10)
     QFIELD(bBoss)
-    QFIELD(Position)
+    QFIELD(Rank)
+    // world bounds at 1 cm resolution
+    QFIELD_STEP(Position, -8192.0, 8192.0, 0.01)
 END_REFLECTION()
@@ -4,6 +4,8 @@
 #include "Object.h"
 #include "Vector.h"
 
+enum class EMonsterRank : uint8_t { Normal, Elite, Champion, Count };
+
 class QMonster : public QObject
 {
     REFLECTION_BODY(QMonster, QObject)
@@ -12,16 +14,20 @@ private:
     int Level = 10;
     float Rage = 0.25f;
     bool bBoss = false;
+    EMonsterRank Rank = EMonsterRank::Normal;
 
     FVector Position;
 public:
     int GetLevel() const { return Level; }
     float GetRage()  const { return Rage;  }
     bool IsBoss() const { return bBoss; }
+    EMonsterRank GetRank() const { return Rank; }
 
-    void SetLevel(int v) { Level = v; }
-    void SetRage(float v) { Rage  = v; }
-    void SetBoss(bool v) { bBoss = v; }
+    // opted in to change notification
+    void SetLevel(int v) { if (Level == v) return; Level = v; QNOTIFY_CHANGED(Level); }
+    void SetRage(float v) { if (Rage == v) return; Rage = v; QNOTIFY_CHANGED(Rage); }
+    void SetBoss(bool v) { if (bBoss == v) return; bBoss = v; QNOTIFY_CHANGED(bBoss); }
+    void SetRank(EMonsterRank v) { if (Rank == v) return; Rank = v; QNOTIFY_CHANGED(Rank); }
 
     FVector& GetPosition() { return Position; }
     const FVector& GetPositionRef() const { return Position; }
@@ -4,4 +4,6 @@ BEGIN_REFLECTION(Player)
     // Base(Actor) props are included automatically via ForEachProperty
     QFIELD(Ammo)
     QFIELD(Zoom)
+    QFIELD(AccountId)
+    QFIELD(DisplayName)
 END_REFLECTION()
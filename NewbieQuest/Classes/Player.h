@@ -9,4 +9,6 @@ class Player : public Actor
 public:
     int Ammo = 30;
     float Zoom = 1.25f;
+    uint64_t AccountId = 0;
+    std::string DisplayName = "Newbie";
 };
@@ -2,6 +2,7 @@
 
 #include "Reflection/Public/TypeInfos.h"
 #include "Reflection/Public/Property.h"
+#include "Reflection/Public/PropertyHandle.h"
 #include "Reflection/Public/Macros.h"
 #include "Reflection/Public/TypeTraits.h"
 #include "Engine/ObjectFactory.h"
\ No newline at end of file
@@ -0,0 +1,331 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<bit>)
+  #include <bit> // std::endian (C++20)
+#endif
+
+#pragma region Endian
+
+// byte swap(supporting 2/4/8)
+template <class T>
+inline T ByteSwap(T v) {
+    static_assert(std::is_trivially_copyable_v<T>, "byteswap requires trivially copyable type");
+    if constexpr (sizeof(T) == 1) {
+        return v;
+    } else if constexpr (sizeof(T) == 2) {
+        uint16_t x; std::memcpy(&x, &v, 2);
+        x = static_cast<uint16_t>((x << 8) | (x >> 8));
+        std::memcpy(&v, &x, 2);
+        return v;
+    } else if constexpr (sizeof(T) == 4) {
+        uint32_t x; std::memcpy(&x, &v, 4);
+        x = ((x & 0x000000FFu) << 24) |
+            ((x & 0x0000FF00u) << 8)  |
+            ((x & 0x00FF0000u) >> 8)  |
+            ((x & 0xFF000000u) >> 24);
+        std::memcpy(&v, &x, 4);
+        return v;
+    } else if constexpr (sizeof(T) == 8) {
+        uint64_t x; std::memcpy(&x, &v, 8);
+        x =  (x >> 56)
+           | ((x >> 40) & 0x000000000000FF00ull)
+           | ((x >> 24) & 0x0000000000FF0000ull)
+           | ((x >>  8) & 0x00000000FF000000ull)
+           | ((x <<  8) & 0x000000FF00000000ull)
+           | ((x << 24) & 0x0000FF0000000000ull)
+           | ((x << 40) & 0x00FF000000000000ull)
+           |  (x << 56);
+        std::memcpy(&v, &x, 8);
+        return v;
+    } else {
+        // extend it if needed
+        return v;
+    }
+}
+
+// little endian fixation save/restore
+template <class T>
+inline T ToLittleEndian(T v) {
+#if defined(__cpp_lib_endian)
+    if constexpr (std::endian::native == std::endian::little) {
+        return v;
+    } else {
+        return ByteSwap(v);
+    }
+#else
+    #ifdef _WIN32
+        return v; // MSVC/x86 uses little endian
+    #else
+        // conservative swap (adjustable as desired environment)
+        return ByteSwap(v);
+    #endif
+#endif
+}
+
+template <class T>
+inline T FromLittleEndian(T v) {
+    // same logic as ToLittleEndian (symmetry)
+    return ToLittleEndian(v);
+}
+#pragma endregion
+
+#pragma region Archive interface
+
+// Sink for the little-endian binary formats. Backends only implement WriteRaw.
+class FArchiveWriter
+{
+public:
+    virtual ~FArchiveWriter() = default;
+
+    virtual void WriteRaw(const void* Ptr, std::size_t n) = 0;
+    virtual bool IsOk() const = 0;
+
+    inline void Write_Unsigned8 (uint8_t Value)
+    {
+        WriteRaw(&Value, 1);
+    }
+
+    inline void Write_Unsigned16 (uint16_t Value)
+    {
+        Value = ToLittleEndian<uint16_t>(Value);
+        WriteRaw(&Value, 2);
+    }
+
+    inline void Write_Int32 (int32_t Value)
+    {
+        Value = ToLittleEndian<int32_t>(Value); WriteRaw(&Value, 4);
+    }
+
+    inline void Write_Float32 (float v){
+        static_assert(sizeof(float)==4);
+        uint32_t u; std::memcpy(&u, &v, 4);
+        u = ToLittleEndian<uint32_t>(u);
+        WriteRaw(&u, 4);
+    }
+
+    inline void Write_Unsigned64 (uint64_t Value)
+    {
+        Value = ToLittleEndian<uint64_t>(Value); WriteRaw(&Value, 8);
+    }
+
+    inline void Write_Float64 (double v){
+        static_assert(sizeof(double)==8);
+        uint64_t u; std::memcpy(&u, &v, 8);
+        Write_Unsigned64(u);
+    }
+
+    // LEB128: 7 bits per byte, high bit set on all but the last
+    inline void Write_VarUInt (uint64_t Value)
+    {
+        uint8_t Buffer[10];
+        std::size_t n = 0;
+        do {
+            uint8_t Byte = static_cast<uint8_t>(Value & 0x7F);
+            Value >>= 7;
+            if (Value) Byte |= 0x80;
+            Buffer[n++] = Byte;
+        } while (Value);
+        WriteRaw(Buffer, n);
+    }
+
+    inline void WriteStream(const std::string& s){
+        if (s.size() > 0xFFFF) throw std::runtime_error("string too long");
+        Write_Unsigned16(static_cast<uint16_t>(s.size()));
+        if (!s.empty()) WriteRaw(s.data(), s.size());
+    }
+
+    // varint length prefix instead of the fixed 16-bit one
+    inline void WriteVarStream(const std::string& s){
+        Write_VarUInt(s.size());
+        if (!s.empty()) WriteRaw(s.data(), s.size());
+    }
+};
+
+// bytes Write_VarUInt emits for Value
+inline std::size_t VarUIntSize(uint64_t Value)
+{
+    std::size_t n = 1;
+    while (Value >>= 7) ++n;
+    return n;
+}
+
+// Source for the little-endian binary formats. Backends only implement ReadRaw.
+class FArchiveReader
+{
+public:
+    virtual ~FArchiveReader() = default;
+
+    // false (and nothing consumed) if fewer than n bytes remain
+    virtual bool ReadRaw(void* Ptr, std::size_t n) = 0;
+    // bytes left to read; length prefixes are checked against it before allocating
+    virtual std::size_t Remaining() const = 0;
+
+    inline bool Read_Unsigned8 (uint8_t& v)
+    {
+        return ReadRaw(&v, 1);
+    }
+
+    inline bool Read_Unsigned16 (uint16_t& Value)
+    {
+        if (!ReadRaw(&Value, 2)) return false;
+        Value = FromLittleEndian<uint16_t>(Value);
+        return true;
+    }
+
+    inline bool Read_Int32 (int32_t& Value)
+    {
+        if (!ReadRaw(&Value, 4)) return false;
+        Value = FromLittleEndian<int32_t>(Value); return true;
+    }
+
+    inline bool Read_Float32 (float& v){
+        static_assert(sizeof(float)==4);
+        uint32_t u; if (!ReadRaw(&u, 4)) return false;
+        u = FromLittleEndian<uint32_t>(u);
+        std::memcpy(&v, &u, 4);
+        return true;
+    }
+
+    inline bool Read_Unsigned64 (uint64_t& Value)
+    {
+        if (!ReadRaw(&Value, 8)) return false;
+        Value = FromLittleEndian<uint64_t>(Value); return true;
+    }
+
+    inline bool Read_Float64 (double& v){
+        uint64_t u; if (!Read_Unsigned64(u)) return false;
+        std::memcpy(&v, &u, 8);
+        return true;
+    }
+
+    inline bool Read_VarUInt (uint64_t& Value)
+    {
+        Value = 0;
+        for (uint32_t Shift = 0; Shift < 64; Shift += 7) {
+            uint8_t Byte; if (!ReadRaw(&Byte, 1)) return false;
+            Value |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+            if (!(Byte & 0x80)) return true;
+        }
+        return false; // more than 10 bytes
+    }
+
+    inline bool ReadStream(std::string& s){
+        uint16_t n=0; if (!Read_Unsigned16(n)) return false;
+        s.resize(n);
+        return n == 0 || ReadRaw(s.data(), n);
+    }
+
+    inline bool ReadVarStream(std::string& s){
+        uint64_t n=0; if (!Read_VarUInt(n)) return false;
+        if (n > MaxVarStreamLength || n > Remaining()) return false;
+        s.resize(static_cast<std::size_t>(n));
+        return n == 0 || ReadRaw(s.data(), s.size());
+    }
+
+    // guards the allocation against corrupt length prefixes
+    static constexpr uint64_t MaxVarStreamLength = 1ull << 30;
+};
+#pragma endregion
+
+#pragma region Memory backend
+
+// Growable byte buffer. Reserve the final size up front to avoid regrowth.
+class FMemoryWriter final : public FArchiveWriter
+{
+public:
+    FMemoryWriter() = default;
+    explicit FMemoryWriter(std::size_t ReserveBytes) { Bytes.reserve(ReserveBytes); }
+
+    void WriteRaw(const void* Ptr, std::size_t n) override
+    {
+        const auto* p = static_cast<const uint8_t*>(Ptr);
+        Bytes.insert(Bytes.end(), p, p + n);
+    }
+    bool IsOk() const override { return true; }
+
+    void Reserve(std::size_t n) { Bytes.reserve(n); }
+    std::size_t Size() const { return Bytes.size(); }
+    const std::vector<uint8_t>& GetBytes() const { return Bytes; }
+    std::vector<uint8_t> TakeBytes() { return std::move(Bytes); }
+
+    // whole buffer in a single write
+    bool FlushToFile(const std::filesystem::path& Path) const
+    {
+        std::ofstream OutputStream(Path, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!OutputStream) return false;
+        OutputStream.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+        return bool(OutputStream);
+    }
+
+private:
+    std::vector<uint8_t> Bytes;
+};
+
+// Reads from a contiguous buffer it does not own.
+class FSpanReader final : public FArchiveReader
+{
+public:
+    explicit FSpanReader(std::span<const uint8_t> InData) : Data(InData) {}
+
+    bool ReadRaw(void* Ptr, std::size_t n) override
+    {
+        if (n > Data.size() - Pos) return false;
+        std::memcpy(Ptr, Data.data() + Pos, n);
+        Pos += n;
+        return true;
+    }
+
+    std::size_t Tell() const { return Pos; }
+    std::size_t Remaining() const override { return Data.size() - Pos; }
+
+private:
+    std::span<const uint8_t> Data;
+    std::size_t Pos = 0;
+};
+
+// Reads the rest of an opened stream with a single read.
+inline bool ReadStreamToBuffer(std::ifstream& InputStream, std::vector<uint8_t>& OutBytes)
+{
+    const std::streampos Begin = InputStream.tellg();
+    InputStream.seekg(0, std::ios::end);
+    const std::streamoff Size = InputStream.tellg() - Begin;
+    if (Size < 0) return false;
+    InputStream.seekg(Begin);
+    OutBytes.resize(static_cast<std::size_t>(Size));
+    InputStream.read(reinterpret_cast<char*>(OutBytes.data()), static_cast<std::streamsize>(Size));
+    return bool(InputStream);
+}
+
+// Reads exactly KnownSize bytes from an opened stream, without measuring it first.
+// Fails if the stream is shorter or longer, e.g. when the file changed since KnownSize was taken.
+inline bool ReadStreamToBuffer(std::ifstream& InputStream, std::vector<uint8_t>& OutBytes, std::size_t KnownSize)
+{
+    OutBytes.resize(KnownSize);
+    InputStream.read(reinterpret_cast<char*>(OutBytes.data()), static_cast<std::streamsize>(KnownSize));
+    return bool(InputStream) && InputStream.peek() == std::ifstream::traits_type::eof();
+}
+
+// Reads a whole file with a single read. Returns false if the file can't be opened or read.
+inline bool ReadFileToBuffer(const std::filesystem::path& Path, std::vector<uint8_t>& OutBytes)
+{
+    std::ifstream InputStream(Path, std::ios::binary);
+    if (!InputStream) return false;
+    return ReadStreamToBuffer(InputStream, OutBytes);
+}
+
+inline bool ReadFileToBuffer(const std::filesystem::path& Path, std::vector<uint8_t>& OutBytes, std::size_t KnownSize)
+{
+    std::ifstream InputStream(Path, std::ios::binary);
+    if (!InputStream) return false;
+    return ReadStreamToBuffer(InputStream, OutBytes, KnownSize);
+}
+#pragma endregion
@@ -0,0 +1,236 @@
+#include "AssetCooker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "Engine/AssetManager.h"
+#include "Engine/Trace.h"
+
+namespace FileSystem = std::filesystem;
+
+namespace
+{
+    constexpr const char* ManifestHeader = "QCookManifest 1";
+
+    using Clock = std::chrono::steady_clock;
+
+    double MillisecondsSince(Clock::time_point Start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+    }
+
+    unsigned PickThreads(std::size_t NumItems, unsigned NumThreads)
+    {
+        if (NumThreads == 0) NumThreads = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(NumThreads, NumItems)));
+    }
+
+    // Body(Index) for every index in [0, Count), handed out one at a time since item costs vary a lot
+    template <typename Fn>
+    void ParallelForEach(std::size_t Count, unsigned NumThreads, const Fn& Body)
+    {
+        std::atomic<std::size_t> Next{0};
+        auto Worker = [&]{
+            for (std::size_t i = Next++; i < Count; i = Next++) Body(i);
+        };
+        if (NumThreads <= 1) { Worker(); return; }
+        std::vector<std::thread> Threads;
+        for (unsigned t = 0; t < NumThreads; ++t) Threads.emplace_back(Worker);
+        for (std::thread& Thread : Threads) Thread.join();
+    }
+
+    // class name from the "Class=" header line, empty if missing
+    std::string PeekClassName(const std::vector<uint8_t>& Bytes)
+    {
+        const char* Begin = reinterpret_cast<const char*>(Bytes.data());
+        const char* End = Begin + Bytes.size();
+        const char* LineEnd = std::find(Begin, End, '\n');
+        std::string Line(Begin, LineEnd);
+        const auto Pos = Line.find('=');
+        if (Pos == std::string::npos || Line.substr(0, Pos) != "Class") return {};
+        return QAssetManager::Get().Trim(Line.substr(Pos + 1));
+    }
+
+    // Visit(Entry) for every entry of Directory; false with Ec set if listing it failed partway
+    template <typename Fn>
+    bool ListDirectory(const FileSystem::path& Directory, std::error_code& Ec, const Fn& Visit)
+    {
+        FileSystem::directory_iterator It(Directory, Ec);
+        for (const FileSystem::directory_iterator End; !Ec && It != End; It.increment(Ec)) Visit(*It);
+        return !Ec;
+    }
+
+    FCookError ListError(const FileSystem::path& Directory, const FileSystem::path& Root, const std::error_code& Ec)
+    {
+        return { Directory.lexically_relative(Root).generic_string(), "can't list directory: " + Ec.message() };
+    }
+}
+
+void FCookReport::Print(std::ostream& OutputStream) const
+{
+    OutputStream << "Cooked " << NumCooked << ", skipped " << NumSkipped << ", failed " << NumFailed
+                 << " of " << NumFound << " text assets\n";
+    OutputStream << "  scan " << ScanMs << " ms, cook " << CookMs << " ms, manifest " << ManifestMs
+                 << " ms, total " << TotalMs << " ms\n";
+    for (const FCookError& Error : Errors) OutputStream << "  error: " << Error.Path << ": " << Error.Message << "\n";
+}
+
+QAssetCooker::FManifest QAssetCooker::ReadManifest(const FileSystem::path& Path)
+{
+    FManifest Manifest;
+    std::ifstream InputStream(Path);
+    std::string Line;
+    if (!InputStream || !std::getline(InputStream, Line) || Line != ManifestHeader) return Manifest;
+
+    // <content hash> <schema hash> <relative path>, hashes in hex
+    while (std::getline(InputStream, Line)) {
+        std::istringstream Iss(Line);
+        FManifestEntry Entry;
+        std::string RelativePath;
+        if (!(Iss >> std::hex >> Entry.ContentHash >> Entry.SchemaHash)) continue;
+        std::getline(Iss >> std::ws, RelativePath);
+        if (!RelativePath.empty()) Manifest[RelativePath] = Entry;
+    }
+    return Manifest;
+}
+
+bool QAssetCooker::WriteManifest(const FileSystem::path& Path, const FManifest& Manifest)
+{
+    std::ofstream OutputStream(Path, std::ios::out | std::ios::trunc);
+    if (!OutputStream) return false;
+    OutputStream << ManifestHeader << "\n";
+    char Hashes[40];
+    for (const auto& [RelativePath, Entry] : Manifest) {
+        std::snprintf(Hashes, sizeof(Hashes), "%016llx %016llx ",
+                      static_cast<unsigned long long>(Entry.ContentHash), static_cast<unsigned long long>(Entry.SchemaHash));
+        OutputStream << Hashes << RelativePath << "\n";
+    }
+    return bool(OutputStream);
+}
+
+std::vector<FileSystem::path> QAssetCooker::FindTextAssets(const FileSystem::path& Root, unsigned NumThreads,
+                                                           std::vector<FCookError>& Errors)
+{
+    std::vector<FileSystem::path> Found;
+    std::vector<FileSystem::path> Directories;
+    // directory symlinks aren't followed, so a link can't send the walk around in a loop
+    auto Sort = [](const FileSystem::directory_entry& Entry, std::vector<FileSystem::path>& Files,
+                   std::vector<FileSystem::path>& Subdirectories){
+        std::error_code EntryEc;
+        if (Entry.is_directory(EntryEc) && !Entry.is_symlink(EntryEc)) Subdirectories.push_back(Entry.path());
+        else if (Entry.path().extension() == ".qasset_t" && Entry.is_regular_file(EntryEc)) Files.push_back(Entry.path());
+    };
+
+    std::error_code Ec;
+    if (!ListDirectory(Root, Ec, [&](const FileSystem::directory_entry& Entry){ Sort(Entry, Found, Directories); }))
+        Errors.push_back(ListError(Root, Root, Ec));
+
+    // each walk keeps its own stack, so a directory it can't list only loses that subtree
+    std::mutex FoundMutex;
+    ParallelForEach(Directories.size(), PickThreads(Directories.size(), NumThreads), [&](std::size_t i){
+        std::vector<FileSystem::path> Local;
+        std::vector<FCookError> LocalErrors;
+        std::vector<FileSystem::path> Pending{ Directories[i] };
+        while (!Pending.empty()) {
+            const FileSystem::path Directory = std::move(Pending.back());
+            Pending.pop_back();
+            std::error_code WalkEc;
+            if (!ListDirectory(Directory, WalkEc, [&](const FileSystem::directory_entry& Entry){ Sort(Entry, Local, Pending); }))
+                LocalErrors.push_back(ListError(Directory, Root, WalkEc));
+        }
+        std::lock_guard Lock(FoundMutex);
+        Found.insert(Found.end(), Local.begin(), Local.end());
+        Errors.insert(Errors.end(), LocalErrors.begin(), LocalErrors.end());
+    });
+
+    // stable order for the report and the manifest
+    std::ranges::sort(Found);
+    std::ranges::sort(Errors, {}, &FCookError::Path);
+    return Found;
+}
+
+FCookReport QAssetCooker::Cook(unsigned NumThreads, bool bForce)
+{
+    const auto TotalStart = Clock::now();
+    FCookReport Report;
+    QAssetManager& AssetManager = QAssetManager::Get();
+    const FileSystem::path& Root = AssetManager.EnsureAssetRoot();
+    const FileSystem::path ManifestPath = Root / ManifestName;
+
+    auto Start = Clock::now();
+    const FManifest Previous = bForce ? FManifest{} : ReadManifest(ManifestPath);
+    const std::vector<FileSystem::path> Inputs = FindTextAssets(Root, NumThreads, Report.Errors);
+    Report.NumFailed = Report.Errors.size();
+    Report.NumFound = Inputs.size();
+    Report.ScanMs = MillisecondsSince(Start);
+
+    enum class EResult : uint8_t { Cooked, Skipped, Failed };
+    struct FResult
+    {
+        EResult        Result = EResult::Failed;
+        std::string    RelativePath;
+        FManifestEntry Entry;
+        std::vector<std::string> Errors;
+    };
+    std::vector<FResult> Results(Inputs.size());
+
+    Start = Clock::now();
+    ParallelForEach(Inputs.size(), PickThreads(Inputs.size(), NumThreads), [&](std::size_t i){
+        const FileSystem::path& Input = Inputs[i];
+        FResult& Out = Results[i];
+        Out.RelativePath = Input.lexically_relative(Root).generic_string();
+
+        std::vector<uint8_t> Bytes;
+        if (!ReadFileToBuffer(Input, Bytes)) { Out.Errors.push_back("can't read file"); return; }
+
+        const std::string ClassName = PeekClassName(Bytes);
+        const ClassInfo* Info = Registry::Get().Find(ClassName);
+        if (!Info || !Info->Factory) { Out.Errors.push_back("unknown class '" + ClassName + "'"); return; }
+
+        Out.Entry.ContentHash = Fnv1a64(Bytes.data(), Bytes.size());
+        Out.Entry.SchemaHash = Info->GetSchemaHash();
+
+        FileSystem::path Output = Input;
+        Output.replace_extension(".qasset");
+
+        auto It = Previous.find(Out.RelativePath);
+        std::error_code Ec;
+        if (It != Previous.end() && It->second.ContentHash == Out.Entry.ContentHash
+            && It->second.SchemaHash == Out.Entry.SchemaHash && FileSystem::exists(Output, Ec)) {
+            Out.Result = EResult::Skipped;
+            return;
+        }
+
+        QTRACE_ZONE("Cook", Out.RelativePath, ClassName);
+        std::istringstream Text(std::string(Bytes.begin(), Bytes.end()));
+        std::unique_ptr<QObject> Obj = AssetManager.LoadQAssetFromTextStream(Text, Out.RelativePath, &Out.Errors);
+        if (!Obj || !Out.Errors.empty()) { if (Out.Errors.empty()) Out.Errors.push_back("can't parse"); return; }
+
+        if (!AssetManager.SaveQAsset(*Obj, Output.string())) { Out.Errors.push_back("can't write " + Output.string()); return; }
+        Out.Result = EResult::Cooked;
+    });
+    Report.CookMs = MillisecondsSince(Start);
+
+    // failed inputs are left out of the manifest so the next cook retries them
+    Start = Clock::now();
+    FManifest Manifest;
+    for (FResult& Result : Results) {
+        switch (Result.Result) {
+        case EResult::Cooked:  ++Report.NumCooked;  Manifest[Result.RelativePath] = Result.Entry; break;
+        case EResult::Skipped: ++Report.NumSkipped; Manifest[Result.RelativePath] = Result.Entry; break;
+        case EResult::Failed:
+            ++Report.NumFailed;
+            for (std::string& Message : Result.Errors) Report.Errors.push_back({ Result.RelativePath, std::move(Message) });
+            break;
+        }
+    }
+    if (!WriteManifest(ManifestPath, Manifest)) Report.Errors.push_back({ ManifestName, "can't write manifest" });
+    Report.ManifestMs = MillisecondsSince(Start);
+
+    Report.TotalMs = MillisecondsSince(TotalStart);
+    return Report;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct FCookError
+{
+    std::string Path;       // relative to the asset root
+    std::string Message;
+};
+
+struct FCookReport
+{
+    std::size_t NumFound = 0;     // .qasset_t files under the root
+    std::size_t NumCooked = 0;
+    std::size_t NumSkipped = 0;   // unchanged since the last cook
+    std::size_t NumFailed = 0;    // assets, plus directories that couldn't be listed
+
+    double ScanMs = 0.0;
+    double CookMs = 0.0;
+    double ManifestMs = 0.0;
+    double TotalMs = 0.0;
+
+    std::vector<FCookError> Errors;
+
+    void Print(std::ostream& OutputStream) const;
+};
+
+// Converts every text asset (.qasset_t) under QAssetManager's asset root into a binary
+// .qasset next to it. Text assets are validated against the registry first: an unknown
+// class, an unknown property, a type mismatch or an unparsable value fails that asset.
+//
+// The manifest (CookManifest.txt in the root) keeps, per input, the content hash of the
+// text and the schema hash of its class at the last successful cook. An input whose
+// hashes both match and whose output still exists is skipped.
+//
+// Classes register on their first StaticClass() call, so every class that may appear in
+// the assets must have been touched before cooking.
+class QAssetCooker
+{
+public:
+    // NumThreads = 0 picks the hardware concurrency; bForce ignores the manifest
+    FCookReport Cook(unsigned NumThreads = 0, bool bForce = false);
+
+    static constexpr const char* ManifestName = "CookManifest.txt";
+
+private:
+    struct FManifestEntry
+    {
+        uint64_t ContentHash = 0;
+        uint64_t SchemaHash = 0;
+    };
+    using FManifest = std::map<std::string, FManifestEntry>;
+
+    static FManifest ReadManifest(const std::filesystem::path& Path);
+    static bool      WriteManifest(const std::filesystem::path& Path, const FManifest& Manifest);
+
+    // every .qasset_t under Root; top-level directories are walked on separate threads.
+    // A directory that can't be listed is skipped with an entry in Errors.
+    static std::vector<std::filesystem::path> FindTextAssets(const std::filesystem::path& Root, unsigned NumThreads,
+                                                             std::vector<FCookError>& Errors);
+};
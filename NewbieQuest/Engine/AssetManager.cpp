@@ -1,159 +1,619 @@
 ﻿#include "AssetManager.h"
 #include <filesystem>
+#include <thread>
+#include "Engine/SharedAssetCache.h"
+#include "Engine/Trace.h"
 
 namespace FileSystem = std::filesystem;
 
-static FileSystem::path& RootStorage() {
-    static FileSystem::path Root;
-    return Root;
+namespace
+{
+    // extensions stripped from asset names before the requested one is appended
+    constexpr std::string_view AssetExtensions[] = { ".qasset_t", ".qasset", ".qworld" };
+
+    // the version a shared cache entry is checked against: changes whenever the file is rewritten
+    bool ReadAssetVersion(const FileSystem::path& Path, uint64_t& Version)
+    {
+        std::error_code Ec;
+        const uint64_t Size = FileSystem::file_size(Path, Ec);
+        if (Ec) return false;
+        const int64_t WriteTime = FileSystem::last_write_time(Path, Ec).time_since_epoch().count();
+        if (Ec) return false;
+        Version = Fnv1a64(&WriteTime, sizeof(WriteTime), Fnv1a64(&Size, sizeof(Size)));
+        return true;
+    }
 }
 
 void QAssetManager::SetAssetRoot(const FileSystem::path& Path)
 {
-    RootStorage() = Path; 
+    AssetRoot = Path;
+    bRootCreated = false;
+    UnmountAssets();
+}
+
+const FileSystem::path& QAssetManager::GetAssetRoot()
+{
+    if (AssetRoot.empty()) AssetRoot = FileSystem::current_path() / "Contents";
+    return AssetRoot;
 }
 
 const FileSystem::path& QAssetManager::EnsureAssetRoot()
 {
-    auto& Root = RootStorage();
-    if (Root.empty()) Root = FileSystem::current_path() / "Contents";
-    FileSystem::create_directories(Root);
+    const FileSystem::path& Root = GetAssetRoot();
+    if (!bRootCreated) {
+        FileSystem::create_directories(Root);
+        bRootCreated = true;
+    }
     return Root;
 }
 
-FileSystem::path QAssetManager::MakeAssetPath(std::string Name)
+std::string QAssetManager::NormalizeAssetName(std::string_view Name, std::string_view Extension)
 {
-    if (Name.size() < 7 || Name.substr(Name.size() - 7) != ".qasset")
-        Name += ".qasset";
-    FileSystem::path FullPath = EnsureAssetRoot() / Name;
+    std::string Key;
+    Key.reserve(Name.size() + Extension.size());
+    for (char c : Name) {
+        if (c == '\\') c = '/';
+        if (c == '/' && (Key.empty() || Key.back() == '/')) continue; // leading and doubled separators
+        Key += c;
+    }
+    while (Key.starts_with("./")) Key.erase(0, 2);
+
+    for (std::string_view Known : AssetExtensions) {
+        if (Key.ends_with(Known)) { Key.resize(Key.size() - Known.size()); break; }
+    }
+    Key += Extension;
+    return Key;
+}
+
+FileSystem::path QAssetManager::MakeAssetPath(std::string_view Name, std::string_view Extension)
+{
+    const std::string Key = NormalizeAssetName(Name, Extension);
+    QTRACE_ZONE("ResolvePath", Key);
+    FileSystem::path FullPath = EnsureAssetRoot() / Key;
     FileSystem::create_directories(FullPath.parent_path());
     return FullPath;
 }
 
+FileSystem::path QAssetManager::ResolveAssetPath(std::string_view Name, std::string_view Extension)
+{
+    const std::string Key = NormalizeAssetName(Name, Extension);
+    QTRACE_ZONE("ResolvePath", Key);
+    {
+        std::shared_lock Lock(MountMutex);
+        if (bMounted) {
+            auto It = Mounted.find(Key);
+            if (It != Mounted.end()) return It->second.Path;
+        }
+    }
+    return GetAssetRoot() / Key;
+}
+
+std::size_t QAssetManager::MountAssets()
+{
+    const FileSystem::path& Root = GetAssetRoot();
+    const std::string RootString = Root.string();
+    QTRACE_ZONE("Mount", RootString);
+
+    std::unordered_map<std::string, FMountedAsset> Found;
+    std::error_code Ec;
+    for (const auto& Entry : FileSystem::recursive_directory_iterator(Root, Ec)) {
+        const std::string Extension = Entry.path().extension().string();
+        if (std::ranges::find(AssetExtensions, std::string_view(Extension)) == std::end(AssetExtensions)) continue;
+        if (!Entry.is_regular_file(Ec)) continue;
+
+        const std::uintmax_t Size = Entry.file_size(Ec);
+        if (Ec) continue;
+        const std::string Key = NormalizeAssetName(Entry.path().lexically_relative(Root).generic_string(), Extension);
+        Found[Key] = { Entry.path(), Size };
+    }
+
+    std::unique_lock Lock(MountMutex);
+    Mounted = std::move(Found);
+    bMounted = true;
+    return Mounted.size();
+}
+
+void QAssetManager::UnmountAssets()
+{
+    std::unique_lock Lock(MountMutex);
+    Mounted.clear();
+    bMounted = false;
+}
+
+bool QAssetManager::IsMounted() const
+{
+    std::shared_lock Lock(MountMutex);
+    return bMounted;
+}
+
+bool QAssetManager::FindMountedAsset(std::string_view Name, std::string_view Extension, FMountedAsset& Out) const
+{
+    const std::string Key = NormalizeAssetName(Name, Extension);
+    std::shared_lock Lock(MountMutex);
+    auto It = Mounted.find(Key);
+    if (It == Mounted.end()) return false;
+    Out = It->second;
+    return true;
+}
+
+void QAssetManager::NoteAssetWritten(const std::string& Key, const FileSystem::path& Path, std::uintmax_t Size)
+{
+    std::unique_lock Lock(MountMutex);
+    if (bMounted) Mounted[Key] = { Path, Size };
+}
+
 bool QAssetManager::SaveAssetByText(const QObject& Obj, std::string Name)
 {
-    FileSystem::path FullPath = MakeAssetPath(std::move(Name));
-    FullPath.replace_extension(".qasset_t");
-    return SaveQAssetAsText(Obj, FullPath.string());
+    const std::string Key = NormalizeAssetName(Name, ".qasset_t");
+    const FileSystem::path FullPath = MakeAssetPath(Key, ".qasset_t");
+    if (!SaveQAssetAsText(Obj, FullPath.string())) return false;
+    if (IsMounted()) {
+        std::error_code Ec;
+        NoteAssetWritten(Key, FullPath, FileSystem::file_size(FullPath, Ec));
+    }
+    return true;
 }
 
 std::unique_ptr<QObject> QAssetManager::LoadAssetFromText(const std::string Name)
 {
-    FileSystem::path FullPath = MakeAssetPath(Name);
-    FullPath.replace_extension(".qasset_t");
-    return LoadQAssetByText(FullPath.string());
+    if (IsMounted()) {
+        FMountedAsset Asset;
+        if (!FindMountedAsset(Name, ".qasset_t", Asset)) return nullptr;
+        return LoadQAssetByText(Asset.Path.string());
+    }
+    return LoadQAssetByText(ResolveAssetPath(Name, ".qasset_t").string());
 }
 
 bool QAssetManager::SaveAsset(const QObject& Obj, const std::string Name)
 {
-    auto FullPath = MakeAssetPath(Name);
-    return SaveQAsset(Obj, FullPath.string());
+    const std::string Key = NormalizeAssetName(Name);
+    const FileSystem::path FullPath = MakeAssetPath(Key);
+    if (!SaveQAsset(Obj, FullPath.string())) return false;
+    if (IsMounted()) NoteAssetWritten(Key, FullPath, ComputeBinarySize(Obj));
+    return true;
 }
 
 std::unique_ptr<QObject> QAssetManager::LoadAssetBinary(const std::string Name)
 {
-    auto FullPath = MakeAssetPath(Name);
-    return LoadQAsset(FullPath.string());
+    FileSystem::path Path;
+    std::size_t KnownSize = UnknownSize;
+    if (IsMounted()) {
+        FMountedAsset Asset;
+        if (!FindMountedAsset(Name, ".qasset", Asset)) return nullptr;
+        Path = Asset.Path;
+        KnownSize = static_cast<std::size_t>(Asset.Size);
+    } else {
+        Path = ResolveAssetPath(Name);
+    }
+
+    // shared entries are keyed by absolute path (other asset roots are other assets)
+    // and checked against the file's version, so a rewritten asset misses
+    std::string Key;
+    uint64_t Version = 0;
+    const bool bShared = SharedCache && ReadAssetVersion(Path, Version);
+    if (bShared) {
+        Key = FileSystem::absolute(Path).lexically_normal().generic_string();
+        if (std::unique_ptr<QObject> Shared = SharedCache->Build(Key, Version)) return Shared;
+    }
+
+    std::unique_ptr<QObject> Obj = LoadQAsset(Path.string(), KnownSize);
+    // a file rewritten while it was read would publish new bytes under the old version
+    uint64_t ReadVersion = 0;
+    if (Obj && bShared && ReadAssetVersion(Path, ReadVersion) && ReadVersion == Version)
+        SharedCache->Publish(Key, Version, *Obj);
+    return Obj;
 }
 
-bool QAssetManager::SaveQAsset(const QObject& Obj, const std::string& Path)
+namespace
 {
-    std::ofstream OutputStream(Path, std::ios::binary | std::ios::out | std::ios::trunc);
-    if (!OutputStream) return false;
+    constexpr uint16_t BinaryVersion = 3;
 
-    constexpr char Magic[4] = {'Q','A','S','B'};
-    OutputStream.write(Magic, 4);
-    Write_Unsigned16(OutputStream, 2); // version 2: leaf-flat (structs flattened)
-    Write_Unsigned16(OutputStream, 0);
+    // binary TypeKind codes; v2 only knows the first three
+    enum : uint8_t
+    {
+        BinaryKindBool, BinaryKindInt, BinaryKindFloat,
+        BinaryKindInt8, BinaryKindInt16, BinaryKindInt64,
+        BinaryKindUInt8, BinaryKindUInt16, BinaryKindUInt32, BinaryKindUInt64,
+        BinaryKindDouble, BinaryKindEnum, BinaryKindString,
+        BinaryKindUEnum,    // enum with an unsigned underlying type
+        BinaryKindCount
+    };
+
+    uint8_t ToBinaryKind(const LeafInfo& Leaf)
+    {
+        switch (Leaf.Kind) {
+        case BasicKind::Bool:   return BinaryKindBool;
+        case BasicKind::Int:    return BinaryKindInt;
+        case BasicKind::Float:  return BinaryKindFloat;
+        case BasicKind::Int8:   return BinaryKindInt8;
+        case BasicKind::Int16:  return BinaryKindInt16;
+        case BasicKind::Int64:  return BinaryKindInt64;
+        case BasicKind::UInt8:  return BinaryKindUInt8;
+        case BasicKind::UInt16: return BinaryKindUInt16;
+        case BasicKind::UInt32: return BinaryKindUInt32;
+        case BasicKind::UInt64: return BinaryKindUInt64;
+        case BasicKind::Double: return BinaryKindDouble;
+        case BasicKind::Enum:   return IsUnsignedIntegerKind(Leaf.ValueKind) ? BinaryKindUEnum : BinaryKindEnum;
+        case BasicKind::String: return BinaryKindString;
+        default: throw std::runtime_error("non-primitive leaf");
+        }
+    }
 
-    ClassInfo& Info = Obj.GetClassInfo();
-    WriteStream(OutputStream, Info.Name);
-    WriteStream(OutputStream, Obj.GetObjectName());
+    // varint payload of an integer or enum leaf: zigzag for signed storage, plain for unsigned
+    uint64_t VarIntPayload(const LeafInfo& Leaf, const void* Ptr)
+    {
+        const int64_t v = LoadInteger(Ptr, Leaf.ValueKind);
+        return IsUnsignedIntegerKind(Leaf.ValueKind) ? static_cast<uint64_t>(v) : ZigZagEncode(v);
+    }
 
-    // gather leaf 
-    struct LeafRow { std::string Name; const PropertyBase* P; const void* Owner; };
-    std::vector<LeafRow> Rows;
-    ForEachLeafConst(Obj, [&](const std::string& full, const PropertyBase& Leaf, const void* OwnerPtr){
-        Rows.push_back({ full, &Leaf, OwnerPtr });
-    });
+    std::size_t BinaryValueSize(const LeafInfo& Leaf, const void* Ptr)
+    {
+        switch (Leaf.Kind) {
+        case BasicKind::Bool:   return 1;
+        case BasicKind::Float:  return 4;
+        case BasicKind::Double: return 8;
+        case BasicKind::String: {
+            const std::size_t n = reinterpret_cast<const std::string*>(Ptr)->size();
+            return VarUIntSize(n) + n;
+        }
+        default: return VarUIntSize(VarIntPayload(Leaf, Ptr));
+        }
+    }
 
-    if (Rows.size()>0xFFFF) throw std::runtime_error("too many leaf properties");
-    Write_Unsigned16(OutputStream, (uint16_t)Rows.size());
+    void WriteBinaryValue(FArchiveWriter& Writer, const LeafInfo& Leaf, const void* Ptr)
+    {
+        switch (Leaf.Kind) {
+        case BasicKind::Bool:   Writer.Write_Unsigned8(*reinterpret_cast<const bool*>(Ptr) ? 1u : 0u); break;
+        case BasicKind::Float:  Writer.Write_Float32(*reinterpret_cast<const float*>(Ptr)); break;
+        case BasicKind::Double: Writer.Write_Float64(*reinterpret_cast<const double*>(Ptr)); break;
+        case BasicKind::String: Writer.WriteVarStream(*reinterpret_cast<const std::string*>(Ptr)); break;
+        default:                Writer.Write_VarUInt(VarIntPayload(Leaf, Ptr)); break;
+        }
+    }
 
-    for (auto& Row : Rows) {
-        WriteStream(OutputStream, Row.Name);
-        uint8_t Kind = (Row.P->Kind == BasicKind::Bool) ? 0 : (Row.P->Kind == BasicKind::Int) ? 1 : (Row.P->Kind == BasicKind::Float) ? 2 : 0xFF;
-        if (Kind==0xFF) throw std::runtime_error("non-primitive leaf");
-        Write_Unsigned8(OutputStream, Kind);
+    // Reads one value of the given TypeKind and stores it if Leaf has that kind; a mismatched
+    // or unknown leaf still consumes the value so the following records stay aligned.
+    bool ReadBinaryValue(FArchiveReader& Reader, uint16_t Version, uint8_t Kind, const LeafInfo* Leaf, void* Ptr)
+    {
+        if (Version < 3 && Kind > BinaryKindFloat) return false;
+        if (Kind >= BinaryKindCount) return false;
+        const bool bApply = Leaf && ToBinaryKind(*Leaf) == Kind;
 
-        const void* VoidPtr = Row.P->ConstPtr(Row.Owner);
         switch (Kind) {
-        case 0: {uint8_t b = (*reinterpret_cast<const bool*>(VoidPtr)) ? 1u : 0u; Write_Unsigned8(OutputStream,b); } break;
-        case 1: { int32_t v = (int32_t)(*reinterpret_cast<const int*>(VoidPtr)); Write_Int32(OutputStream,v); } break;
-        case 2: { float v = *reinterpret_cast<const float*>(VoidPtr); Write_Float32(OutputStream,v); } break;
-        default: { throw std::runtime_error("non-primitive leaf");}
+        case BinaryKindBool: {
+            uint8_t b=0; if (!Reader.Read_Unsigned8(b)) return false;
+            if (bApply) *reinterpret_cast<bool*>(Ptr) = (b!=0);
+        } break;
+        case BinaryKindFloat: {
+            float v=0; if (!Reader.Read_Float32(v)) return false;
+            if (bApply) *reinterpret_cast<float*>(Ptr) = v;
+        } break;
+        case BinaryKindDouble: {
+            double v=0; if (!Reader.Read_Float64(v)) return false;
+            if (bApply) *reinterpret_cast<double*>(Ptr) = v;
+        } break;
+        case BinaryKindString: {
+            std::string v; if (!Reader.ReadVarStream(v)) return false;
+            if (bApply) *reinterpret_cast<std::string*>(Ptr) = std::move(v);
+        } break;
+        default: {
+            int64_t v = 0;
+            if (Version < 3) {
+                int32_t Fixed=0; if (!Reader.Read_Int32(Fixed)) return false;
+                v = Fixed;
+            } else {
+                uint64_t Payload=0; if (!Reader.Read_VarUInt(Payload)) return false;
+                const bool bUnsigned = (Kind >= BinaryKindUInt8 && Kind <= BinaryKindUInt64) || Kind == BinaryKindUEnum;
+                v = bUnsigned ? static_cast<int64_t>(Payload) : ZigZagDecode(Payload);
+            }
+            if (bApply) StoreInteger(Ptr, Leaf->ValueKind, v);
+        } break;
+        }
+        return true;
+    }
+
+    constexpr char     WorldMagic[4] = {'Q','W','L','D'};
+    constexpr uint16_t WorldVersion = 1;
+    constexpr std::size_t WorldHeaderSize = 4 + 2 + 2 + 8;
+
+    // below this a world isn't worth spawning threads for
+    constexpr std::size_t ParallelWorldThreshold = 1024;
+
+    // Body(ThreadIndex, Begin, End) over NumThreads contiguous ranges of [0, Count)
+    template <typename Fn>
+    void ParallelRanges(std::size_t Count, unsigned NumThreads, const Fn& Body)
+    {
+        if (NumThreads <= 1) { Body(0u, std::size_t(0), Count); return; }
+        std::vector<std::thread> Threads;
+        const std::size_t Chunk = (Count + NumThreads - 1) / NumThreads;
+        for (unsigned t = 0; t < NumThreads; ++t) {
+            const std::size_t Begin = std::min(Count, t * Chunk);
+            Threads.emplace_back(Body, t, Begin, std::min(Count, Begin + Chunk));
         }
+        for (std::thread& Thread : Threads) Thread.join();
+    }
+
+    unsigned PickWorldThreads(std::size_t Count, unsigned NumThreads)
+    {
+        if (NumThreads == 0) NumThreads = std::max(1u, std::thread::hardware_concurrency());
+        if (Count < ParallelWorldThreshold) return 1;
+        return static_cast<unsigned>(std::min<std::size_t>(NumThreads, Count));
+    }
+
+    // records are normally written in leaf order, so try the expected slot before searching
+    const LeafInfo* FindLeaf(const std::vector<LeafInfo>& Leaves, std::size_t Expected, const std::string& Name)
+    {
+        if (Expected < Leaves.size() && Leaves[Expected].Path == Name) return &Leaves[Expected];
+        for (const LeafInfo& Leaf : Leaves) if (Leaf.Path == Name) return &Leaf;
+        return nullptr;
     }
-    return bool(OutputStream);
 }
 
-std::unique_ptr<QObject> QAssetManager::LoadQAsset(const std::string& Path)
+bool QAssetManager::SaveQAsset(const QObject& Obj, const std::string& Path)
 {
-    std::ifstream InputStream(Path, std::ios::binary);
+    FMemoryWriter Writer;
+    {
+        QTRACE_ZONE("Serialize", Path, Obj.GetClassInfo().Name);
+        Writer.Reserve(ComputeBinarySize(Obj));
+        if (!SerializeBinary(Obj, Writer)) return false;
+    }
+    QTRACE_ZONE("Write", Path, Obj.GetClassInfo().Name);
+    return Writer.FlushToFile(Path);
+}
+
+std::unique_ptr<QObject> QAssetManager::LoadQAsset(const std::string& Path, std::size_t KnownSize)
+{
+    std::ifstream InputStream;
+    {
+        QTRACE_ZONE("Open", Path);
+        InputStream.open(Path, std::ios::binary);
+    }
     if (!InputStream) return nullptr;
 
-    char Magic[4]; InputStream.read(Magic,4);
-    if (!InputStream || std::memcmp(Magic,"QASB",4)!=0) return nullptr;
+    std::vector<uint8_t> Bytes;
+    {
+        QTRACE_ZONE("Read", Path);
+        const bool bRead = KnownSize == UnknownSize ? ReadStreamToBuffer(InputStream, Bytes)
+                                                    : ReadStreamToBuffer(InputStream, Bytes, KnownSize);
+        if (!bRead) return nullptr;
+    }
+    return LoadFromBuffer(Bytes);
+}
 
-    uint16_t Version=0, Reserved=0;
-    if (!Read_Unsigned16(InputStream,Version) || !Read_Unsigned16(InputStream,Reserved)) return nullptr;
-    if (Version != 2) return nullptr; // process only v2
+bool QAssetManager::SaveToBuffer(const QObject& Obj, std::vector<uint8_t>& OutBytes)
+{
+    FMemoryWriter Writer(ComputeBinarySize(Obj));
+    if (!SerializeBinary(Obj, Writer)) return false;
+    OutBytes = Writer.TakeBytes();
+    return true;
+}
 
-    std::string ClassName, ObjectName;
-    if (!ReadStream(InputStream,ClassName) || !ReadStream(InputStream,ObjectName)) return nullptr;
+std::unique_ptr<QObject> QAssetManager::LoadFromBuffer(std::span<const uint8_t> Bytes)
+{
+    FSpanReader Reader(Bytes);
+    return DeserializeBinary(Reader);
+}
 
-    ClassInfo* Info = Registry::Get().Find(ClassName);
-    if (!Info || !Info->Factory) return nullptr;
+bool QAssetManager::SaveWorld(std::span<const QObject* const> Objects, const std::string& Name, unsigned NumThreads)
+{
+    const std::string Key = NormalizeAssetName(Name, ".qworld");
+    const FileSystem::path Path = MakeAssetPath(Key, ".qworld");
+    const std::string PathString = Path.string();
+    const unsigned Threads = PickWorldThreads(Objects.size(), NumThreads);
+
+    // each thread serializes a contiguous range into its own buffer
+    std::vector<FMemoryWriter> Buffers(Threads);
+    std::vector<uint64_t> RecordSizes(Objects.size());
+    std::vector<uint8_t> Failed(Threads, 0);
+    {
+        QTRACE_ZONE("Serialize", PathString);
+        ParallelRanges(Objects.size(), Threads, [&](unsigned t, std::size_t Begin, std::size_t End){
+            FMemoryWriter& Writer = Buffers[t];
+            // objects of a shard are mostly alike, so the first one sizes the buffer
+            if (Begin < End && Objects[Begin]) Writer.Reserve((End - Begin) * ComputeBinarySize(*Objects[Begin]));
+            for (std::size_t i = Begin; i < End; ++i) {
+                const std::size_t Before = Writer.Size();
+                if (!Objects[i] || !SerializeBinary(*Objects[i], Writer)) { Failed[t] = 1; return; }
+                RecordSizes[i] = Writer.Size() - Before;
+            }
+        });
+    }
+    if (std::ranges::find(Failed, 1) != Failed.end()) return false;
+
+    // prefix sums give every record's offset without touching the record bytes again
+    FMemoryWriter Header(WorldHeaderSize + 8 * (Objects.size() + 1));
+    Header.WriteRaw(WorldMagic, 4);
+    Header.Write_Unsigned16(WorldVersion);
+    Header.Write_Unsigned16(0);
+    Header.Write_Unsigned64(Objects.size());
+    uint64_t Offset = 0;
+    Header.Write_Unsigned64(Offset);
+    for (uint64_t Size : RecordSizes) Header.Write_Unsigned64(Offset += Size);
+
+    QTRACE_ZONE("Write", PathString);
+    std::ofstream OutputStream(Path, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!OutputStream) return false;
+    OutputStream.write(reinterpret_cast<const char*>(Header.GetBytes().data()), static_cast<std::streamsize>(Header.Size()));
+    std::uintmax_t FileSize = Header.Size();
+    for (const FMemoryWriter& Buffer : Buffers) {
+        OutputStream.write(reinterpret_cast<const char*>(Buffer.GetBytes().data()), static_cast<std::streamsize>(Buffer.Size()));
+        FileSize += Buffer.Size();
+    }
+    if (!OutputStream) return false;
+    NoteAssetWritten(Key, Path, FileSize);
+    return true;
+}
 
-    std::unique_ptr<QObject> Obj = Info->Factory();
-    Obj->SetObjectName(ObjectName);
+bool QAssetManager::LoadWorld(const std::string& Name, std::vector<std::unique_ptr<QObject>>& OutObjects, unsigned NumThreads)
+{
+    // read once so both branches agree if another thread mounts or unmounts meanwhile
+    const bool bFromMount = IsMounted();
+    FMountedAsset World;
+    if (bFromMount) {
+        if (!FindMountedAsset(Name, ".qworld", World)) return false;
+    } else {
+        World.Path = ResolveAssetPath(Name, ".qworld");
+    }
+    const std::string PathString = World.Path.string();
 
-    uint16_t count=0; if (!Read_Unsigned16(InputStream,count)) return nullptr;
+    std::vector<uint8_t> Bytes;
+    {
+        QTRACE_ZONE("Read", PathString);
+        const bool bRead = bFromMount ? ReadFileToBuffer(World.Path, Bytes, static_cast<std::size_t>(World.Size))
+                                     : ReadFileToBuffer(World.Path, Bytes);
+        if (!bRead) return false;
+    }
 
-    // leaf setter map
-    std::unordered_map<std::string, const PropertyBase*> Properties;
-    std::unordered_map<std::string, void*> Owners;
-    ForEachLeaf(*Obj, [&](const std::string& full, const PropertyBase& Leaf, void* OwnerPtr){
-        Properties[full]  = &Leaf;
-        Owners[full] = OwnerPtr;
+    std::vector<uint64_t> Offsets;
+    std::size_t RecordArea = 0;
+    {
+        QTRACE_ZONE("Parse", PathString);
+        FSpanReader Reader(Bytes);
+        char Magic[4];
+        uint16_t Version = 0, Reserved = 0;
+        uint64_t Count = 0;
+        if (!Reader.ReadRaw(Magic, 4) || std::memcmp(Magic, WorldMagic, 4) != 0) return false;
+        if (!Reader.Read_Unsigned16(Version) || !Reader.Read_Unsigned16(Reserved) || Version != WorldVersion) return false;
+        if (!Reader.Read_Unsigned64(Count) || Count >= Reader.Remaining() / 8) return false;
+
+        Offsets.resize(static_cast<std::size_t>(Count) + 1);
+        for (uint64_t& Offset : Offsets) if (!Reader.Read_Unsigned64(Offset)) return false;
+
+        RecordArea = Reader.Tell();
+        const std::size_t RecordBytes = Bytes.size() - RecordArea;
+        if (Offsets.front() != 0 || Offsets.back() != RecordBytes) return false;
+        for (std::size_t i = 1; i < Offsets.size(); ++i) if (Offsets[i] < Offsets[i - 1]) return false;
+    }
+
+    const std::size_t Count = Offsets.size() - 1;
+    const unsigned Threads = PickWorldThreads(Count, NumThreads);
+    std::vector<std::unique_ptr<QObject>> Objects(Count);
+    std::vector<uint8_t> Failed(Threads, 0);
+
+    const std::span<const uint8_t> Records = std::span<const uint8_t>(Bytes).subspan(RecordArea);
+    ParallelRanges(Count, Threads, [&](unsigned t, std::size_t Begin, std::size_t End){
+        for (std::size_t i = Begin; i < End; ++i) {
+            FSpanReader Reader(Records.subspan(Offsets[i], Offsets[i + 1] - Offsets[i]));
+            Objects[i] = DeserializeBinary(Reader);
+            if (!Objects[i]) { Failed[t] = 1; return; }
+        }
     });
+    if (std::ranges::find(Failed, 1) != Failed.end()) return false;
 
-    for (uint16_t i=0; i<count; ++i) {
-        std::string Name; if (!ReadStream(InputStream,Name)) return nullptr;
-        uint8_t Kind=0xFF; if (!Read_Unsigned8(InputStream,Kind)) return nullptr;
+    OutObjects.reserve(OutObjects.size() + Count);
+    for (auto& Obj : Objects) OutObjects.push_back(std::move(Obj));
+    return true;
+}
 
-        auto It = Properties.find(Name);
-        const PropertyBase* Pb = (It==Properties.end()? nullptr : It->second);
-        void* OwnerPtr = (Pb? Owners[Name] : nullptr);
+std::size_t QAssetManager::ComputeBinarySize(const QObject& Obj)
+{
+    const ClassInfo& Info = Obj.GetClassInfo();
+    const std::vector<LeafInfo>& Leaves = Info.GetLeaves();
+    std::size_t Size = 4 + 2 + 2;                          // magic, version, reserved
+    Size += VarUIntSize(Info.Name.size()) + Info.Name.size();
+    Size += VarUIntSize(Obj.GetObjectName().size()) + Obj.GetObjectName().size();
+    Size += VarUIntSize(Leaves.size());
+    for (const LeafInfo& Leaf : Leaves)
+        Size += VarUIntSize(Leaf.Path.size()) + Leaf.Path.size() + 1 + BinaryValueSize(Leaf, Leaf.ConstPtr(Obj));
+    return Size;
+}
 
-        switch (Kind) {
-            case 0: { uint8_t b=0; if(!Read_Unsigned8(InputStream,b)) return nullptr;
-                      if (Pb && Pb->Kind==BasicKind::Bool)  *reinterpret_cast<bool*>(Pb->Ptr(OwnerPtr))  = (b!=0); } break;
-            case 1: { int32_t v=0; if(!Read_Int32(InputStream,v)) return nullptr;
-                      if (Pb && Pb->Kind==BasicKind::Int)   *reinterpret_cast<int*>(Pb->Ptr(OwnerPtr))   = (int)v; } break;
-            case 2: { float v=0;   if(!Read_Float32(InputStream,v)) return nullptr;
-                      if (Pb && Pb->Kind==BasicKind::Float) *reinterpret_cast<float*>(Pb->Ptr(OwnerPtr)) = v; } break;
-            default: return nullptr;
-        }
+bool QAssetManager::SerializeBinary(const QObject& Obj, FArchiveWriter& Writer)
+{
+    constexpr char Magic[4] = {'Q','A','S','B'};
+    Writer.WriteRaw(Magic, 4);
+    Writer.Write_Unsigned16(BinaryVersion);
+    Writer.Write_Unsigned16(0);
+
+    const ClassInfo& Info = Obj.GetClassInfo();
+    Writer.WriteVarStream(Info.Name);
+    Writer.WriteVarStream(Obj.GetObjectName());
+
+    const std::vector<LeafInfo>& Leaves = Info.GetLeaves();
+    Writer.Write_VarUInt(Leaves.size());
+
+    for (const LeafInfo& Leaf : Leaves) {
+        Writer.WriteVarStream(Leaf.Path);
+        Writer.Write_Unsigned8(ToBinaryKind(Leaf));
+        WriteBinaryValue(Writer, Leaf, Leaf.ConstPtr(Obj));
     }
-    return Obj;
+    return Writer.IsOk();
+}
+
+std::unique_ptr<QObject> QAssetManager::DeserializeBinary(FArchiveReader& Reader)
+{
+    FBinaryLoadState State;
+    if (!BeginDeserialize(Reader, State)) return nullptr;
+    if (!StepDeserialize(Reader, State, State.RecordCount)) return nullptr;
+    return std::move(State.Object);
+}
+
+bool QAssetManager::BeginDeserialize(FArchiveReader& Reader, FBinaryLoadState& State)
+{
+    std::string ClassName;
+    {
+        QTraceZone ParseZone("Parse", {});
+
+        char Magic[4];
+        if (!Reader.ReadRaw(Magic,4) || std::memcmp(Magic,"QASB",4)!=0) return false;
+
+        uint16_t Reserved=0;
+        if (!Reader.Read_Unsigned16(State.Version) || !Reader.Read_Unsigned16(Reserved)) return false;
+        if (State.Version != 2 && State.Version != BinaryVersion) return false; // v1 isn't leaf-flat
+
+        const bool bVarNames = State.Version >= 3;
+        if (!(bVarNames ? Reader.ReadVarStream(ClassName) : Reader.ReadStream(ClassName))) return false;
+        if (!(bVarNames ? Reader.ReadVarStream(State.ObjectName) : Reader.ReadStream(State.ObjectName))) return false;
+        ParseZone.SetAssetName(State.ObjectName);
+        ParseZone.SetClassName(ClassName);
+
+        State.Info = Registry::Get().Find(ClassName);
+        if (!State.Info || !State.Info->Factory) return false;
+    }
+
+    QTRACE_ZONE("Factory", State.ObjectName, ClassName);
+    State.Object = State.Info->Factory();
+    State.Object->SetObjectName(State.ObjectName);
+
+    State.NextRecord = 0;
+    if (State.Version < 3) {
+        uint16_t Count=0; if (!Reader.Read_Unsigned16(Count)) return false;
+        State.RecordCount = Count;
+        return true;
+    }
+    uint64_t Count=0;
+    if (!Reader.Read_VarUInt(Count) || Count > 0xFFFFFFFFu) return false;
+    State.RecordCount = static_cast<uint32_t>(Count);
+    return true;
+}
+
+bool QAssetManager::StepDeserialize(FArchiveReader& Reader, FBinaryLoadState& State, std::size_t MaxRecords)
+{
+    if (!State.Object) return false;
+    QTRACE_ZONE("ApplyProperties", State.ObjectName, State.Info->Name);
+
+    QObject& Obj = *State.Object;
+    const std::vector<LeafInfo>& Leaves = State.Info->GetLeaves();
+    std::string Name;
+    const bool bVarNames = State.Version >= 3;
+    for (std::size_t Step = 0; Step < MaxRecords && State.NextRecord < State.RecordCount; ++Step, ++State.NextRecord) {
+        if (!(bVarNames ? Reader.ReadVarStream(Name) : Reader.ReadStream(Name))) return false;
+        uint8_t Kind=0xFF; if (!Reader.Read_Unsigned8(Kind)) return false;
+
+        const LeafInfo* Leaf = FindLeaf(Leaves, State.NextRecord, Name);
+        void* Ptr = Leaf ? Leaf->Ptr(Obj) : nullptr;
+        if (!ReadBinaryValue(Reader, State.Version, Kind, Leaf, Ptr)) return false;
+    }
+    return true;
 }
 
 bool QAssetManager::SaveQAssetAsText(const QObject& Obj, const std::string& Path) {
+    ClassInfo& Info = Obj.GetClassInfo();
+    QTRACE_ZONE("Write", Path, Info.Name);
+
     std::ofstream OutputStream(Path, std::ios::out | std::ios::trunc);
     if (!OutputStream) return false;
 
-    ClassInfo& Info = Obj.GetClassInfo();
     OutputStream << "Class=" << Info.Name << "\n";
     OutputStream << "ObjectName=" << Obj.GetObjectName() << "\n";
 
@@ -166,27 +626,51 @@ bool QAssetManager::SaveQAssetAsText(const QObject& Obj, const std::string& Path
 
 std::unique_ptr<QObject> QAssetManager::LoadQAssetByText(const std::string& Path)
 {
-    std::ifstream InputStream(Path);
+    std::ifstream InputStream;
+    {
+        QTRACE_ZONE("Open", Path);
+        InputStream.open(Path);
+    }
     if (!InputStream) return nullptr;
+    return LoadQAssetFromTextStream(InputStream, Path);
+}
 
-    std::string Line, ClassName, ObjectName;
+std::unique_ptr<QObject> QAssetManager::LoadQAssetFromTextStream(std::istream& InputStream, const std::string& Path,
+                                                                 std::vector<std::string>* OutErrors)
+{
+    auto Report = [&](std::string Message){ if (OutErrors) OutErrors->push_back(std::move(Message)); };
 
-    if (!std::getline(InputStream, Line)) return nullptr;
+    std::string Line, ClassName, ObjectName;
+    ClassInfo* Info = nullptr;
     {
-        auto Pos = Line.find('='); if (Pos==std::string::npos || Line.substr(0,Pos)!="Class") return nullptr;
-        ClassName = Trim(Line.substr(Pos+1));
+        QTraceZone ParseZone("Parse", Path);
+
+        if (!std::getline(InputStream, Line)) { Report("empty file"); return nullptr; }
+        {
+            auto Pos = Line.find('=');
+            if (Pos==std::string::npos || Line.substr(0,Pos)!="Class") { Report("expected Class= on line 1"); return nullptr; }
+            ClassName = Trim(Line.substr(Pos+1));
+        }
+        if (!std::getline(InputStream, Line)) { Report("missing ObjectName= line"); return nullptr; }
+        {
+            auto Pos = Line.find('=');
+            if (Pos==std::string::npos || Line.substr(0,Pos)!="ObjectName") { Report("expected ObjectName= on line 2"); return nullptr; }
+            ObjectName = Trim(Line.substr(Pos+1));
+        }
+        ParseZone.SetClassName(ClassName);
+
+        Info = Registry::Get().Find(ClassName);
+        if (!Info || !Info->Factory) { Report("unknown class '" + ClassName + "'"); return nullptr; }
     }
-    if (!std::getline(InputStream, Line)) return nullptr;
+
+    std::unique_ptr<QObject> Obj;
     {
-        auto Pos = Line.find('='); if (Pos==std::string::npos || Line.substr(0,Pos)!="ObjectName") return nullptr;
-        ObjectName = Trim(Line.substr(Pos+1));
+        QTRACE_ZONE("Factory", Path, ClassName);
+        Obj = Info->Factory();
+        Obj->SetObjectName(ObjectName);
     }
 
-    ClassInfo* Info = Registry::Get().Find(ClassName);
-    if (!Info || !Info->Factory) return nullptr;
-
-    std::unique_ptr<QObject> Obj = Info->Factory();
-    Obj->SetObjectName(ObjectName);
+    QTRACE_ZONE("ApplyProperties", Path, ClassName);
 
     // leaf setter map: "Foo.X" -> (leaf property, ownerPtr(=Foo struct address))
     std::unordered_map<std::string, const PropertyBase*> Props;
@@ -198,23 +682,27 @@ std::unique_ptr<QObject> QAssetManager::LoadQAssetByText(const std::string& Path
     });
 
     // name:type=value
+    // unknown names, type mismatches and bad values are skipped (and reported)
+    std::size_t LineNumber = 2;
     while (std::getline(InputStream, Line)) {
+        ++LineNumber;
         Line = Trim(Line); if (Line.empty()) continue;
+        const std::string Where = "line " + std::to_string(LineNumber) + ": ";
         auto Pos1 = Line.find(':'), Pos2 = Line.find('=');
-        if (Pos1==std::string::npos || Pos2==std::string::npos || Pos1>Pos2) continue;
+        if (Pos1==std::string::npos || Pos2==std::string::npos || Pos1>Pos2) { Report(Where + "expected name:type=value"); continue; }
 
         std::string Pname = Trim(Line.substr(0, Pos1));
         std::string Tname = Trim(Line.substr(Pos1+1, Pos2-(Pos1+1)));
         std::string Value = Trim(Line.substr(Pos2+1));
 
         auto Itp = Props.find(Pname);
-        if (Itp == Props.end()) continue;
+        if (Itp == Props.end()) { Report(Where + "unknown property '" + Pname + "'"); continue; }
 
         const PropertyBase* Pb = Itp->second;
-        if (Pb->TypeName != Tname) continue;
+        if (Pb->TypeName != Tname) { Report(Where + "'" + Pname + "' is " + Pb->TypeName + ", not " + Tname); continue; }
 
         void* OwnerPtr = Owners[Pname];
-        Pb->SetFromString(OwnerPtr, Value);
+        if (!Pb->SetFromString(OwnerPtr, Value)) Report(Where + "bad " + Tname + " value '" + Value + "'");
     }
     
     return Obj;
@@ -1,15 +1,19 @@
 ﻿#pragma once
 #include <memory>
+#include <filesystem>
 #include <fstream>
+#include <span>
 #include <string>
 #include <functional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include "CoreMinimal.h"
-
-#if __has_include(<bit>)
-  #include <bit> // std::endian (C++20)
-#endif
+#include "Engine/Archive.h"
 
 class QObject;
+class QSharedAssetCache;
 
 namespace FileSystem = std::filesystem;
 
@@ -20,43 +24,122 @@ public:
 
     static QAssetManager& Get() { static QAssetManager AssetManager; return AssetManager; }
     
-    void SetAssetRoot(const FileSystem::path& Path);
-    const FileSystem::path& EnsureAssetRoot();
-    FileSystem::path MakeAssetPath(std::string Name);  // append .qasset if missing
+    void SetAssetRoot(const FileSystem::path& Path);   // also unmounts
+    const FileSystem::path& GetAssetRoot();            // no filesystem calls once resolved
+    const FileSystem::path& EnsureAssetRoot();         // creates the root directory once
+
+    // "Monsters\\Orc", "./Monsters/Orc.qasset" -> "Monsters/Orc<Extension>"
+    static std::string NormalizeAssetName(std::string_view Name, std::string_view Extension = ".qasset");
+
+    // write side: creates the missing directories
+    FileSystem::path MakeAssetPath(std::string_view Name, std::string_view Extension = ".qasset");
+    // read side: the mounted entry, or plain path arithmetic; never touches the filesystem
+    FileSystem::path ResolveAssetPath(std::string_view Name, std::string_view Extension = ".qasset");
+
+    // Mounted manifest: one scan of the root maps every normalized asset name to its path and size.
+    // While mounted, loads are served from it (unknown names fail without a filesystem lookup)
+    // and saves through this manager keep it current. Mount again to pick up files added
+    // by other tools.
+    struct FMountedAsset
+    {
+        FileSystem::path Path;
+        std::uintmax_t   Size = 0;
+    };
+    std::size_t MountAssets();                         // returns the number of assets found
+    void UnmountAssets();
+    bool IsMounted() const;
+    bool FindMountedAsset(std::string_view Name, std::string_view Extension, FMountedAsset& Out) const;
 
     bool SaveAssetByText(const QObject& Obj, std::string Name);
     std::unique_ptr<QObject> LoadAssetFromText(const std::string Name);
 
     bool SaveAsset(const QObject& Obj, const std::string Name);
+    // with a shared cache set, served from it when another process already published the asset;
+    // otherwise loaded from disk and published
     std::unique_ptr<QObject> LoadAssetBinary(const std::string Name);
 
+    // opened by the caller, who keeps it alive; null detaches
+    void SetSharedCache(QSharedAssetCache* Cache) { SharedCache = Cache; }
+    QSharedAssetCache* GetSharedCache() const { return SharedCache; }
+
     template<typename T>
     requires std::is_base_of_v<QObject, T>
     inline bool SaveAsset(const std::unique_ptr<T>& p, const std::string& path)
     {
         return p ? SaveAsset(*p, path) : false;
     }
-    // Little-endian binary .qasset
-    // format v1:
-    //  [4]  Magic "QASB"
-    //  [2]  Version = 1
-    //  [2]  Reserved = 0
-    //  [2]  ClassNameLen
-    //  [N]  ClassName (UTF-8)
-    //  [2]  ObjectNameLen
-    //  [N]  ObjectName (UTF-8)
-    //  [2]  PropertyCount
+    // Little-endian binary .qasset, [var] is an LEB128 varint
+    // format v3:
+    //  [4]   Magic "QASB"
+    //  [2]   Version = 3
+    //  [2]   Reserved = 0
+    //  [var] ClassNameLen
+    //  [N]   ClassName (UTF-8)
+    //  [var] ObjectNameLen
+    //  [N]   ObjectName (UTF-8)
+    //  [var] PropertyCount
     //  repeat PropertyCount count:
-    //     [2] NameLen
-    //     [N] Name (UTF-8)
-    //     [1] TypeKind (0=Bool, 1=Int, 2=Float)
-    //     [V] Value (Bool:1, Int:4, Float:4)
+    //     [var] NameLen
+    //     [N]   Name (UTF-8), flattened leaf path
+    //     [1]   TypeKind (0=Bool, 1=Int, 2=Float, 3=Int8, 4=Int16, 5=Int64, 6=UInt8,
+    //                     7=UInt16, 8=UInt32, 9=UInt64, 10=Double, 11=Enum, 12=String,
+    //                     13=UEnum (enum with an unsigned underlying type))
+    //     [V]   Value: Bool 1, Float 4, Double 8,
+    //                  signed ints and Enum zigzag varint, unsigned ints and UEnum varint,
+    //                  String varint length + bytes
+    // Values stay byte-aligned, so small enums take one byte rather than being bit-packed
+    // (only snapshots bit-pack them).
+    // v2 (still loaded) uses 16-bit lengths and counts, and a 4-byte Int.
     bool SaveQAsset(const QObject& Obj, const std::string& Path);
-    std::unique_ptr<QObject> LoadQAsset(const std::string& Path);
+    // KnownSize (e.g. from the mounted manifest) saves the seeks that measure the file
+    std::unique_ptr<QObject> LoadQAsset(const std::string& Path, std::size_t KnownSize = UnknownSize);
+    static constexpr std::size_t UnknownSize = static_cast<std::size_t>(-1);
+
+    // binary .qasset to/from memory, e.g. to embed assets in other storage or network frames
+    bool SaveToBuffer(const QObject& Obj, std::vector<uint8_t>& OutBytes);
+    std::unique_ptr<QObject> LoadFromBuffer(std::span<const uint8_t> Bytes);
+
+    // Whole world in one file (Name with a .qworld extension), serialized and loaded in parallel.
+    // NumThreads = 0 picks the hardware concurrency.
+    //  [4]  Magic "QWLD"
+    //  [2]  Version = 1
+    //  [2]  Reserved = 0
+    //  [8]  ObjectCount
+    //  [8]  x (ObjectCount + 1) record offsets into the record area (prefix sums of the record sizes)
+    //  [N]  records, each a binary .qasset
+    bool SaveWorld(std::span<const QObject* const> Objects, const std::string& Name, unsigned NumThreads = 0);
+    bool LoadWorld(const std::string& Name, std::vector<std::unique_ptr<QObject>>& OutObjects, unsigned NumThreads = 0);
+
+    // binary .qasset to/from any archive backend
+    bool SerializeBinary(const QObject& Obj, FArchiveWriter& Writer);
+    std::unique_ptr<QObject> DeserializeBinary(FArchiveReader& Reader);
+
+    // Resumable binary decode: BeginDeserialize parses the header and creates the object,
+    // then each StepDeserialize applies up to MaxRecords property records.
+    struct FBinaryLoadState
+    {
+        std::unique_ptr<QObject> Object;
+        const ClassInfo* Info = nullptr;
+        std::string ObjectName;
+        uint16_t Version = 0;
+        uint32_t RecordCount = 0;
+        uint32_t NextRecord = 0;
+
+        bool IsDone() const { return Object && NextRecord == RecordCount; }
+    };
+    bool BeginDeserialize(FArchiveReader& Reader, FBinaryLoadState& State);
+    bool StepDeserialize(FArchiveReader& Reader, FBinaryLoadState& State, std::size_t MaxRecords);
+
+    // exact byte size SerializeBinary will produce
+    std::size_t ComputeBinarySize(const QObject& Obj);
     
     // text .qasset
     bool SaveQAssetAsText(const QObject& Obj, const std::string& Path);
     std::unique_ptr<QObject> LoadQAssetByText(const std::string& Path);
+    // Path only labels trace zones. Problems are appended to OutErrors; a header problem
+    // returns null, bad property lines are skipped.
+    std::unique_ptr<QObject> LoadQAssetFromTextStream(std::istream& InputStream, const std::string& Path,
+                                                      std::vector<std::string>* OutErrors = nullptr);
 
     // debug dump
     void DumpObject(const QObject& Obj, std::ostream& OutputStream);
@@ -67,156 +150,19 @@ public:
         s.erase(std::find_if(s.rbegin(), s.rend(), notspace).base(), s.end());
         return s;
     }
-#pragma region Endian
 
 private:
-    // byte swap(supporting 2/4/8)
-    template <class T>
-    inline T ByteSwap(T v) {
-        static_assert(std::is_trivially_copyable_v<T>, "byteswap requires trivially copyable type");
-        if constexpr (sizeof(T) == 1) {
-            return v;
-        } else if constexpr (sizeof(T) == 2) {
-            uint16_t x; std::memcpy(&x, &v, 2);
-            x = static_cast<uint16_t>((x << 8) | (x >> 8));
-            std::memcpy(&v, &x, 2);
-            return v;
-        } else if constexpr (sizeof(T) == 4) {
-            uint32_t x; std::memcpy(&x, &v, 4);
-            x = ((x & 0x000000FFu) << 24) |
-                ((x & 0x0000FF00u) << 8)  |
-                ((x & 0x00FF0000u) >> 8)  |
-                ((x & 0xFF000000u) >> 24);
-            std::memcpy(&v, &x, 4);
-            return v;
-        } else if constexpr (sizeof(T) == 8) {
-            uint64_t x; std::memcpy(&x, &v, 8);
-            x =  (x >> 56)
-               | ((x >> 40) & 0x000000000000FF00ull)
-               | ((x >> 24) & 0x0000000000FF0000ull)
-               | ((x >>  8) & 0x00000000FF000000ull)
-               | ((x <<  8) & 0x000000FF00000000ull)
-               | ((x << 24) & 0x0000FF0000000000ull)
-               | ((x << 40) & 0x00FF000000000000ull)
-               |  (x << 56);
-            std::memcpy(&v, &x, 8);
-            return v;
-        } else {
-            // extend it if needed
-            return v;
-        }
-    }
+    // record a file written through a Save* call in the mounted manifest
+    void NoteAssetWritten(const std::string& Key, const FileSystem::path& Path, std::uintmax_t Size);
 
-    // little endian fixation save/restore
-    template <class T>
-    inline T ToLittleEndian(T v) {
-    #if defined(__cpp_lib_endian)
-        if constexpr (std::endian::native == std::endian::little) {
-            return v;
-        } else {
-            return ByteSwap(v);
-        }
-    #else
-        #ifdef _WIN32
-            return v; // MSVC/x86 uses little endian
-        #else
-            // conservative swap (adjustable as desired environment)
-            return ByteSwap(v);
-        #endif
-    #endif
-    }
+    FileSystem::path AssetRoot;
+    bool bRootCreated = false;
 
-    template <class T>
-    inline T FromLittleEndian(T v) {
-        // same logic as to_le (symmetry)
-    #if defined(__cpp_lib_endian)
-        if constexpr (std::endian::native == std::endian::little) {
-            return v;
-        } else {
-            return ByteSwap(v);
-        }
-    #else
-        #ifdef _WIN32
-            return v;
-        #else
-            return ByteSwap(v);
-        #endif
-    #endif
-    }
-#pragma endregion
+    mutable std::shared_mutex MountMutex;
+    std::unordered_map<std::string, FMountedAsset> Mounted;
+    bool bMounted = false;
 
-#pragma region Binary I/O
-    
-private:
-    inline void WriteRaw(std::ofstream& OutputStream, const void* Ptr, std::size_t n)
-    {
-        OutputStream.write(reinterpret_cast<const char*>(Ptr), static_cast<std::streamsize>(n));
-    }
-    
-    inline void ReadRaw(std::ifstream& InputStream, void* Ptr, std::size_t n)
-    {
-        InputStream.read(reinterpret_cast<char*>(Ptr), static_cast<std::streamsize>(n));
-    }
-    
-    inline void Write_Unsigned8 (std::ofstream& OutputStream, uint8_t Value)
-    {
-        WriteRaw(OutputStream, &Value, 1);
-    }
-    
-    inline bool Read_Unsigned8 (std::ifstream& InputStream, uint8_t& v)
-    {
-        ReadRaw(InputStream, &v, 1); return bool(InputStream);
-    }
-
-    inline void Write_Unsigned16 (std::ofstream& OutputStream, uint16_t Value)
-    {
-        Value = ToLittleEndian<uint16_t>(Value);
-        WriteRaw(OutputStream, &Value, 2);
-    }
-    
-    inline bool Read_Unsigned16 (std::ifstream& InputStream, uint16_t& Value)
-    {
-        ReadRaw(InputStream, &Value, 2);
-        Value = FromLittleEndian<uint16_t>(Value);
-        return bool(InputStream);
-    }
-
-    inline void Write_Int32 (std::ofstream& OutputStream, int32_t Value)
-    {
-        Value = ToLittleEndian<int32_t>(Value); WriteRaw(OutputStream, &Value, 4);
-    }
-    
-    inline bool Read_Int32 (std::ifstream& InputStream, int32_t& Value)
-    {
-        ReadRaw(InputStream, &Value, 4); Value = FromLittleEndian<int32_t>(Value); return bool(InputStream);
-    }
-
-    inline void Write_Float32 (std::ofstream& OutputStream, float v){
-        static_assert(sizeof(float)==4);
-        uint32_t u; std::memcpy(&u, &v, 4);
-        u = ToLittleEndian<uint32_t>(u);
-        WriteRaw(OutputStream, &u, 4);
-    }
-    inline bool  Read_Float32 (std::ifstream& InputStream, float& v){
-        static_assert(sizeof(float)==4);
-        uint32_t u; ReadRaw(InputStream, &u, 4);
-        u = FromLittleEndian<uint32_t>(u);
-        std::memcpy(&v, &u, 4);
-        return bool(InputStream);
-    }
-
-    inline void WriteStream(std::ofstream& OutputStream, const std::string& s){
-        if (s.size() > 0xFFFF) throw std::runtime_error("string too long");
-        Write_Unsigned16(OutputStream, static_cast<uint16_t>(s.size()));
-        if (!s.empty()) WriteRaw(OutputStream, s.data(), s.size());
-    }
-    inline bool ReadStream(std::ifstream& is, std::string& s){
-        uint16_t n=0; if (!Read_Unsigned16(is, n)) return false;
-        s.resize(n);
-        if (n) ReadRaw(is, s.data(), n);
-        return bool(is);
-    }
-#pragma endregion
+    QSharedAssetCache* SharedCache = nullptr;
 
 #pragma region Walk down to leaf
 
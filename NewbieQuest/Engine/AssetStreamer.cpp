@@ -0,0 +1,149 @@
+#include "AssetStreamer.h"
+#include "Engine/Trace.h"
+
+QAssetStreamer::QAssetStreamer()
+{
+    IoThread = std::thread([this]{ IoLoop(); });
+}
+
+QAssetStreamer::~QAssetStreamer()
+{
+    {
+        std::lock_guard Lock(Mutex);
+        bStopping = true;
+    }
+    WakeIo.notify_all();
+    IoThread.join();
+}
+
+FStreamHandle QAssetStreamer::RequestLoad(const std::string& Name, int Priority, FOnLoaded OnLoaded)
+{
+    auto Request = std::make_shared<FRequest>();
+    QAssetManager& AssetManager = QAssetManager::Get();
+    QAssetManager::FMountedAsset Asset;
+    if (AssetManager.FindMountedAsset(Name, ".qasset", Asset)) {
+        Request->Path = Asset.Path.string();
+        Request->KnownSize = static_cast<std::size_t>(Asset.Size);
+    } else {
+        Request->Path = AssetManager.ResolveAssetPath(Name).string();
+    }
+    Request->Priority = Priority;
+    Request->OnLoaded = std::move(OnLoaded);
+
+    FStreamHandle Handle;
+    {
+        std::lock_guard Lock(Mutex);
+        Handle = Request->Handle = NextHandle++;
+        Requests.emplace(Handle, std::move(Request));
+    }
+    WakeIo.notify_one();
+    return Handle;
+}
+
+bool QAssetStreamer::Cancel(FStreamHandle Handle)
+{
+    // an in-flight read or decode keeps its own reference and is dropped when it finishes
+    std::lock_guard Lock(Mutex);
+    return Requests.erase(Handle) > 0;
+}
+
+bool QAssetStreamer::SetPriority(FStreamHandle Handle, int Priority)
+{
+    std::lock_guard Lock(Mutex);
+    auto It = Requests.find(Handle);
+    if (It == Requests.end()) return false;
+    It->second->Priority = Priority;
+    return true;
+}
+
+std::size_t QAssetStreamer::GetNumPending() const
+{
+    std::lock_guard Lock(Mutex);
+    return Requests.size();
+}
+
+std::shared_ptr<QAssetStreamer::FRequest> QAssetStreamer::PickLocked(bool bDecodable) const
+{
+    std::shared_ptr<FRequest> Best;
+    for (const auto& [Handle, Request] : Requests) {
+        const bool bMatches = bDecodable
+            ? (Request->State == EState::Ready || Request->State == EState::Decoding)
+            : Request->State == EState::Queued;
+        if (!bMatches) continue;
+        if (!Best || Request->Priority > Best->Priority
+                  || (Request->Priority == Best->Priority && Request->Handle < Best->Handle)) {
+            Best = Request;
+        }
+    }
+    return Best;
+}
+
+void QAssetStreamer::IoLoop()
+{
+    for (;;) {
+        std::shared_ptr<FRequest> Request;
+        {
+            std::unique_lock Lock(Mutex);
+            WakeIo.wait(Lock, [&]{ return bStopping || (Request = PickLocked(false)) != nullptr; });
+            if (bStopping) return;
+            Request->State = EState::Reading;
+        }
+
+        std::vector<uint8_t> Bytes;
+        bool bOk;
+        {
+            QTRACE_ZONE("Read", Request->Path);
+            bOk = Request->KnownSize == QAssetManager::UnknownSize ? ReadFileToBuffer(Request->Path, Bytes)
+                                                                   : ReadFileToBuffer(Request->Path, Bytes, Request->KnownSize);
+        }
+
+        std::lock_guard Lock(Mutex);
+        Request->Bytes = std::move(Bytes);
+        Request->bReadFailed = !bOk;
+        Request->State = EState::Ready;
+    }
+}
+
+void QAssetStreamer::Tick(std::chrono::microseconds Budget)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto Deadline = Clock::now() + Budget;
+    QAssetManager& AssetManager = QAssetManager::Get();
+
+    auto Finish = [this](const std::shared_ptr<FRequest>& Request, std::unique_ptr<QObject> Object) {
+        {
+            std::lock_guard Lock(Mutex);
+            if (Requests.erase(Request->Handle) == 0) return; // cancelled meanwhile
+        }
+        if (Request->OnLoaded) Request->OnLoaded(Request->Handle, std::move(Object));
+    };
+
+    bool bFirstSlice = true;
+    while (bFirstSlice || Clock::now() < Deadline) {
+        bFirstSlice = false;
+
+        std::shared_ptr<FRequest> Request;
+        {
+            std::lock_guard Lock(Mutex);
+            Request = PickLocked(true);
+        }
+        if (!Request) break;
+
+        if (Request->State == EState::Ready) {
+            if (Request->bReadFailed) { Finish(Request, nullptr); continue; }
+
+            Request->Reader = std::make_unique<FSpanReader>(Request->Bytes);
+            if (!AssetManager.BeginDeserialize(*Request->Reader, Request->Load)) { Finish(Request, nullptr); continue; }
+
+            std::lock_guard Lock(Mutex);
+            Request->State = EState::Decoding;
+            continue;
+        }
+
+        if (!AssetManager.StepDeserialize(*Request->Reader, Request->Load, RecordsPerSlice)) {
+            Finish(Request, nullptr);
+        } else if (Request->Load.IsDone()) {
+            Finish(Request, std::move(Request->Load.Object));
+        }
+    }
+}
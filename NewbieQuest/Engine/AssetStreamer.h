@@ -0,0 +1,79 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Engine/AssetManager.h"
+
+class QObject;
+
+using FStreamHandle = uint64_t;
+
+// Incremental binary asset loading under a per-tick time budget.
+// File bytes are read on a background thread; object construction and property
+// application run on the thread calling Tick, in small slices, so a burst of
+// requests is spread over several frames instead of stalling one.
+class QAssetStreamer
+{
+public:
+    // Object is null if the asset couldn't be read or decoded. Not called for cancelled requests.
+    using FOnLoaded = std::function<void(FStreamHandle, std::unique_ptr<QObject>)>;
+
+    QAssetStreamer();
+    ~QAssetStreamer();
+
+    QAssetStreamer(const QAssetStreamer&) = delete;
+    QAssetStreamer& operator=(const QAssetStreamer&) = delete;
+
+    // higher priority is read and finished first; equal priorities keep request order
+    FStreamHandle RequestLoad(const std::string& Name, int Priority, FOnLoaded OnLoaded);
+
+    // false if the request already completed or is unknown
+    bool Cancel(FStreamHandle Handle);
+    bool SetPriority(FStreamHandle Handle, int Priority);
+
+    // Decode ready requests until Budget is used up. At least one slice runs per call.
+    // Completion callbacks are invoked from here.
+    void Tick(std::chrono::microseconds Budget);
+
+    std::size_t GetNumPending() const;
+
+    // property records applied per slice between budget checks
+    static constexpr std::size_t RecordsPerSlice = 8;
+
+private:
+    enum class EState : uint8_t { Queued, Reading, Ready, Decoding };
+
+    struct FRequest
+    {
+        FStreamHandle Handle = 0;
+        std::string   Path;
+        std::size_t   KnownSize = QAssetManager::UnknownSize; // from the mounted manifest
+        int           Priority = 0;
+        FOnLoaded     OnLoaded;
+        EState        State = EState::Queued;
+        bool          bReadFailed = false;
+
+        std::vector<uint8_t> Bytes;
+        std::unique_ptr<FSpanReader> Reader;
+        QAssetManager::FBinaryLoadState Load;
+    };
+
+    void IoLoop();
+    // highest priority request that is ready to decode (or waiting to be read), oldest first.
+    // Mutex must be held.
+    std::shared_ptr<FRequest> PickLocked(bool bDecodable) const;
+
+    mutable std::mutex Mutex;
+    std::condition_variable WakeIo;
+    std::unordered_map<FStreamHandle, std::shared_ptr<FRequest>> Requests;
+    FStreamHandle NextHandle = 1;
+    bool bStopping = false;
+    std::thread IoThread;
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+// LSB-first bit stream. Bits are gathered in a 64-bit scratch word and
+// flushed to the byte buffer 32 bits at a time.
+class FBitWriter
+{
+public:
+    void Reserve(std::size_t Bytes) { Buffer.reserve(Bytes); }
+
+    // write the low NumBits (0..32) of Value
+    inline void WriteBits(uint32_t Value, uint32_t NumBits)
+    {
+        if (NumBits == 0) return;
+        if (NumBits < 32) Value &= (1u << NumBits) - 1u;
+        Scratch |= static_cast<uint64_t>(Value) << ScratchBits;
+        ScratchBits += NumBits;
+        if (ScratchBits >= 32) {
+            const uint32_t Word = static_cast<uint32_t>(Scratch);
+            const uint8_t Bytes[4] = { uint8_t(Word), uint8_t(Word >> 8), uint8_t(Word >> 16), uint8_t(Word >> 24) };
+            Buffer.insert(Buffer.end(), Bytes, Bytes + 4);
+            Scratch >>= 32;
+            ScratchBits -= 32;
+        }
+        TotalBits += NumBits;
+    }
+
+    inline void WriteBool(bool b) { WriteBits(b ? 1u : 0u, 1); }
+
+    inline void WriteBits64(uint64_t Value, uint32_t NumBits)
+    {
+        if (NumBits > 32) {
+            WriteBits(static_cast<uint32_t>(Value), 32);
+            WriteBits(static_cast<uint32_t>(Value >> 32), NumBits - 32);
+        } else {
+            WriteBits(static_cast<uint32_t>(Value), NumBits);
+        }
+    }
+
+    // 7 bits per group, high bit = more groups follow
+    inline void WriteVarUInt(uint64_t Value)
+    {
+        while (Value >= 0x80) { WriteBits(static_cast<uint32_t>(Value & 0x7F) | 0x80u, 8); Value >>= 7; }
+        WriteBits(static_cast<uint32_t>(Value), 8);
+    }
+
+    inline void WriteString(const std::string& s)
+    {
+        WriteVarUInt(s.size());
+        for (char c : s) WriteBits(static_cast<uint8_t>(c), 8);
+    }
+
+    // pad to a byte boundary and return the packed bytes
+    const std::vector<uint8_t>& Finish()
+    {
+        while (ScratchBits > 0) {
+            Buffer.push_back(static_cast<uint8_t>(Scratch));
+            Scratch >>= 8;
+            ScratchBits = ScratchBits > 8 ? ScratchBits - 8 : 0;
+        }
+        return Buffer;
+    }
+
+    std::size_t GetNumBits() const { return TotalBits; }
+
+    void Reset() { Buffer.clear(); Scratch = 0; ScratchBits = 0; TotalBits = 0; }
+
+private:
+    std::vector<uint8_t> Buffer;
+    uint64_t    Scratch = 0;
+    uint32_t    ScratchBits = 0;
+    std::size_t TotalBits = 0;
+};
+
+class FBitReader
+{
+public:
+    explicit FBitReader(std::span<const uint8_t> InData) : Data(InData) {}
+
+    // read NumBits (0..32); reading past the end sets the error flag and yields zeros
+    inline uint32_t ReadBits(uint32_t NumBits)
+    {
+        if (NumBits == 0) return 0;
+        while (ScratchBits < NumBits) {
+            if (BytePos < Data.size()) {
+                Scratch |= static_cast<uint64_t>(Data[BytePos++]) << ScratchBits;
+            } else {
+                bError = true;
+            }
+            ScratchBits += 8;
+        }
+        const uint32_t Value = NumBits < 32
+            ? static_cast<uint32_t>(Scratch) & ((1u << NumBits) - 1u)
+            : static_cast<uint32_t>(Scratch);
+        Scratch >>= NumBits;
+        ScratchBits -= NumBits;
+        return Value;
+    }
+
+    inline bool ReadBool() { return ReadBits(1) != 0; }
+
+    inline uint64_t ReadBits64(uint32_t NumBits)
+    {
+        if (NumBits > 32) {
+            const uint64_t Low = ReadBits(32);
+            return Low | (static_cast<uint64_t>(ReadBits(NumBits - 32)) << 32);
+        }
+        return ReadBits(NumBits);
+    }
+
+    inline uint64_t ReadVarUInt()
+    {
+        uint64_t Value = 0;
+        for (uint32_t Shift = 0; Shift < 64 && !bError; Shift += 7) {
+            const uint32_t Group = ReadBits(8);
+            Value |= static_cast<uint64_t>(Group & 0x7F) << Shift;
+            if ((Group & 0x80) == 0) break;
+        }
+        return Value;
+    }
+
+    inline bool ReadString(std::string& s)
+    {
+        const uint64_t n = ReadVarUInt();
+        if (bError || n > Data.size() * 8) { bError = true; return false; }
+        s.resize(static_cast<std::size_t>(n));
+        for (auto& c : s) c = static_cast<char>(ReadBits(8));
+        return !bError;
+    }
+
+    bool IsError() const { return bError; }
+
+private:
+    std::span<const uint8_t> Data;
+    std::size_t BytePos = 0;
+    uint64_t    Scratch = 0;
+    uint32_t    ScratchBits = 0;
+    bool        bError = false;
+};
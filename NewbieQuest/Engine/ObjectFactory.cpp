@@ -0,0 +1,47 @@
+#include "ObjectFactory.h"
+#include <cstring>
+
+namespace
+{
+    inline void ApplyCopyPlan(const std::vector<CopyRun>& Plan, const QObject& Source, QObject& Target)
+    {
+        const char* Src = reinterpret_cast<const char*>(&Source);
+        char* Dst = reinterpret_cast<char*>(&Target);
+        for (const CopyRun& Run : Plan) {
+            if (Run.bString) {
+                *reinterpret_cast<std::string*>(Dst + Run.Offset) = *reinterpret_cast<const std::string*>(Src + Run.Offset);
+            } else {
+                std::memcpy(Dst + Run.Offset, Src + Run.Offset, Run.Size);
+            }
+        }
+    }
+}
+
+std::unique_ptr<QObject> DuplicateObject(const QObject& Source, std::string NewName)
+{
+    const ClassInfo& Info = Source.GetClassInfo();
+    if (!Info.Factory) return nullptr;
+
+    std::unique_ptr<QObject> Clone = Info.Factory();
+    ApplyCopyPlan(Info.GetCopyPlan(), Source, *Clone);
+    Clone->SetObjectName(std::move(NewName));
+    return Clone;
+}
+
+std::vector<std::unique_ptr<QObject>> DuplicateObjects(const QObject& Source, std::size_t Count, const std::string& NamePrefix)
+{
+    std::vector<std::unique_ptr<QObject>> Clones;
+    const ClassInfo& Info = Source.GetClassInfo();
+    if (!Info.Factory) return Clones;
+
+    // resolve the plan once for the whole batch
+    const std::vector<CopyRun>& Plan = Info.GetCopyPlan();
+    Clones.reserve(Count);
+    for (std::size_t i = 0; i < Count; ++i) {
+        std::unique_ptr<QObject> Clone = Info.Factory();
+        ApplyCopyPlan(Plan, Source, *Clone);
+        Clone->SetObjectName(NamePrefix + "_" + std::to_string(i));
+        Clones.push_back(std::move(Clone));
+    }
+    return Clones;
+}
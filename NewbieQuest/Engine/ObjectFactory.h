@@ -2,6 +2,7 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <vector>
 #include "Object.h"
 
 // Create an instance by new and set ObjectName
@@ -13,3 +14,18 @@ std::unique_ptr<T> NewObject(std::string name, Args&&... args)
     obj->SetObjectName(std::move(name));
     return obj;
 }
+
+
+// Copy all reflected properties of Source into a new instance of its class.
+// Runs the class copy plan (see ClassInfo::GetCopyPlan), so no per-property dispatch happens.
+std::unique_ptr<QObject> DuplicateObject(const QObject& Source, std::string NewName);
+
+template <typename T>
+requires std::is_base_of_v<QObject, T>
+std::unique_ptr<T> DuplicateObject(const T& Source, std::string NewName)
+{
+    return std::unique_ptr<T>(static_cast<T*>(DuplicateObject(static_cast<const QObject&>(Source), std::move(NewName)).release()));
+}
+
+// Count clones of Source named "<NamePrefix>_<Index>"
+std::vector<std::unique_ptr<QObject>> DuplicateObjects(const QObject& Source, std::size_t Count, const std::string& NamePrefix);
@@ -0,0 +1,387 @@
+#include "Query.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include "Object.h"
+
+namespace
+{
+    // below this a query isn't worth spawning threads for
+    constexpr std::size_t ParallelQueryThreshold = 16384;
+
+    // rounded constants at or beyond these can't be compared in int64 / uint64
+    constexpr double IntConstantLimit = 0x1p63;
+    constexpr double UIntConstantLimit = 0x1p64;
+
+    // Column[k] = the leaf of row Sel[k], for the m selected rows only
+    template <typename TStored, typename TColumn>
+    void Gather(QObject* const* Rows, const uint16_t* Sel, std::size_t m, std::size_t Offset, TColumn* Column)
+    {
+        for (std::size_t k = 0; k < m; ++k) {
+            TStored v;
+            std::memcpy(&v, reinterpret_cast<const char*>(Rows[Sel[k]]) + Offset, sizeof(TStored));
+            Column[k] = static_cast<TColumn>(v);
+        }
+    }
+
+    template <typename TColumn>
+    void GatherColumn(QObject* const* Rows, const uint16_t* Sel, std::size_t m, std::size_t Offset, BasicKind ValueKind, TColumn* Column)
+    {
+        switch (ValueKind) {
+        case BasicKind::Bool:   Gather<bool,     TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Int8:   Gather<int8_t,   TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Int16:  Gather<int16_t,  TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Int:    Gather<int32_t,  TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Int64:  Gather<int64_t,  TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::UInt8:  Gather<uint8_t,  TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::UInt16: Gather<uint16_t, TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::UInt32: Gather<uint32_t, TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::UInt64: Gather<uint64_t, TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Float:  Gather<float,    TColumn>(Rows, Sel, m, Offset, Column); break;
+        case BasicKind::Double: Gather<double,   TColumn>(Rows, Sel, m, Offset, Column); break;
+        default: std::fill(Column, Column + m, TColumn{}); break;
+        }
+    }
+
+    // the constant lies above (or below) every value the leaf can hold, so the op is decided already
+    void FoldConstant(bool& bConstantResult, bool& bConstantValue, EQueryOp Op, bool bAboveAll)
+    {
+        bConstantResult = true;
+        bConstantValue = Op == EQueryOp::NotEqual
+            || (bAboveAll && (Op == EQueryOp::Less || Op == EQueryOp::LessEqual))
+            || (!bAboveAll && (Op == EQueryOp::Greater || Op == EQueryOp::GreaterEqual));
+    }
+
+    void Accumulate(FQueryAggregate& Out, const double* Values, std::size_t m)
+    {
+        double Sum = 0.0, Min = Out.Min, Max = Out.Max;
+        for (std::size_t k = 0; k < m; ++k) {
+            Sum += Values[k];
+            Min = std::min(Min, Values[k]);
+            Max = std::max(Max, Values[k]);
+        }
+        Out.Count += m;
+        Out.Sum += Sum;
+        Out.Min = Min;
+        Out.Max = Max;
+    }
+}
+
+void FQueryAggregate::Merge(const FQueryAggregate& Other)
+{
+    Count += Other.Count;
+    Sum += Other.Sum;
+    Min = std::min(Min, Other.Min);
+    Max = std::max(Max, Other.Max);
+}
+
+QObjectQuery::QObjectQuery(const ClassInfo& Info) : Class(&Info) {}
+
+bool QObjectQuery::ResolveColumn(std::string_view Path, FColumnLeaf& Out, EColumnKinds Kinds) const
+{
+    const PropertyHandle Handle = PropertyHandle::Resolve(*Class, Path);
+    if (!Handle.IsValid()) return false;
+
+    const BasicKind ValueKind = Handle.GetValueKind();
+    const bool bInteger = IsIntegerKind(ValueKind) || ValueKind == BasicKind::Bool;
+    const bool bReal = ValueKind == BasicKind::Float || ValueKind == BasicKind::Double;
+    switch (Kinds) {
+    case EColumnKinds::Any:      if (!bInteger && !bReal) return false; break;
+    case EColumnKinds::Integer:  if (!bInteger) return false; break;
+    case EColumnKinds::Signed:   if (!bInteger || ValueKind == BasicKind::UInt64) return false; break;
+    case EColumnKinds::Unsigned: if (ValueKind != BasicKind::Bool && !IsUnsignedIntegerKind(ValueKind)) return false; break;
+    }
+
+    Out.Offset = Handle.GetOffset();
+    Out.ValueKind = ValueKind;
+    return true;
+}
+
+bool QObjectQuery::BeginCondition(std::string_view Path, EQueryOp Op, FQueryOpCode& Code)
+{
+    FColumnLeaf Leaf;
+    if (!ResolveColumn(Path, Leaf, EColumnKinds::Any)) { bValid = false; return false; }
+    Code.Offset = Leaf.Offset;
+    Code.ValueKind = Leaf.ValueKind;
+    Code.Op = Op;
+    return true;
+}
+
+QObjectQuery& QObjectQuery::AddCondition(std::string_view Path, EQueryOp Op, int64_t Value)
+{
+    FQueryOpCode Code;
+    if (!BeginCondition(Path, Op, Code)) return *this;
+    Code.FloatConstant = static_cast<double>(Value);
+    if (Code.ValueKind == BasicKind::UInt64) {
+        if (Value < 0) FoldConstant(Code.bConstantResult, Code.bConstantValue, Op, false);
+        else Code.UIntConstant = static_cast<uint64_t>(Value);
+    } else {
+        Code.IntConstant = Value;
+    }
+    FinishCondition(Code);
+    return *this;
+}
+
+QObjectQuery& QObjectQuery::AddCondition(std::string_view Path, EQueryOp Op, uint64_t Value)
+{
+    FQueryOpCode Code;
+    if (!BeginCondition(Path, Op, Code)) return *this;
+    Code.FloatConstant = static_cast<double>(Value);
+    if (Code.ValueKind == BasicKind::UInt64) {
+        Code.UIntConstant = Value;
+    } else if (Value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        // no other integer kind reaches this far; float leaves compare FloatConstant
+        if (Code.ValueKind != BasicKind::Float && Code.ValueKind != BasicKind::Double)
+            FoldConstant(Code.bConstantResult, Code.bConstantValue, Op, true);
+    } else {
+        Code.IntConstant = static_cast<int64_t>(Value);
+    }
+    FinishCondition(Code);
+    return *this;
+}
+
+QObjectQuery& QObjectQuery::AddCondition(std::string_view Path, EQueryOp Op, double Value)
+{
+    FQueryOpCode Code;
+    if (!BeginCondition(Path, Op, Code)) return *this;
+    Code.FloatConstant = Value;
+
+    if (Code.ValueKind != BasicKind::Float && Code.ValueKind != BasicKind::Double) {
+        // move the constant onto the integer grid without changing which integers pass
+        double Rounded = Value;
+        bool bExact = std::floor(Value) == Value;
+        switch (Op) {
+        case EQueryOp::Greater:   case EQueryOp::LessEqual: Rounded = std::floor(Value); bExact = true; break;
+        case EQueryOp::Less:   case EQueryOp::GreaterEqual: Rounded = std::ceil(Value);  bExact = true; break;
+        default: break;
+        }
+
+        const bool bUnsigned = Code.ValueKind == BasicKind::UInt64;
+        // every uint64 is below 2^64 and every int64 in [-2^63, 2^63), and both edges are exact doubles
+        const bool bAboveAll = Rounded >= (bUnsigned ? UIntConstantLimit : IntConstantLimit);
+        const bool bBelowAll = Rounded < (bUnsigned ? 0.0 : -IntConstantLimit);
+        if (std::isnan(Value) || !bExact) {
+            // NaN or a fractional equality never holds
+            Code.bConstantResult = true;
+            Code.bConstantValue = Op == EQueryOp::NotEqual;
+        } else if (bAboveAll || bBelowAll) {
+            FoldConstant(Code.bConstantResult, Code.bConstantValue, Op, bAboveAll);
+        } else if (bUnsigned) {
+            Code.UIntConstant = static_cast<uint64_t>(Rounded);
+        } else {
+            Code.IntConstant = static_cast<int64_t>(Rounded);
+        }
+    }
+
+    FinishCondition(Code);
+    return *this;
+}
+
+template <typename TStored, typename TCompare, EQueryOp Op>
+bool QObjectQuery::TestLeaf(const char* Row, const FQueryOpCode& Code)
+{
+    TStored Stored;
+    std::memcpy(&Stored, Row + Code.Offset, sizeof(TStored));
+    const TCompare Value = static_cast<TCompare>(Stored);
+    TCompare Constant;
+    if constexpr (std::is_same_v<TCompare, uint64_t>) Constant = Code.UIntConstant;
+    else if constexpr (std::is_same_v<TCompare, int64_t>) Constant = Code.IntConstant;
+    else Constant = static_cast<TCompare>(Code.FloatConstant);
+
+    if constexpr (Op == EQueryOp::Equal)          return Value == Constant;
+    else if constexpr (Op == EQueryOp::NotEqual)  return Value != Constant;
+    else if constexpr (Op == EQueryOp::Less)      return Value <  Constant;
+    else if constexpr (Op == EQueryOp::LessEqual) return Value <= Constant;
+    else if constexpr (Op == EQueryOp::Greater)   return Value >  Constant;
+    else                                          return Value >= Constant;
+}
+
+template <typename TStored, typename TCompare>
+QObjectQuery::FRowTest QObjectQuery::PickTest(EQueryOp Op)
+{
+    switch (Op) {
+    case EQueryOp::Equal:        return &TestLeaf<TStored, TCompare, EQueryOp::Equal>;
+    case EQueryOp::NotEqual:     return &TestLeaf<TStored, TCompare, EQueryOp::NotEqual>;
+    case EQueryOp::Less:         return &TestLeaf<TStored, TCompare, EQueryOp::Less>;
+    case EQueryOp::LessEqual:    return &TestLeaf<TStored, TCompare, EQueryOp::LessEqual>;
+    case EQueryOp::Greater:      return &TestLeaf<TStored, TCompare, EQueryOp::Greater>;
+    case EQueryOp::GreaterEqual: return &TestLeaf<TStored, TCompare, EQueryOp::GreaterEqual>;
+    }
+    return nullptr;
+}
+
+void QObjectQuery::FinishCondition(FQueryOpCode& Code)
+{
+    if (Code.bConstantResult) {
+        Code.Test = Code.bConstantValue ? +[](const char*, const FQueryOpCode&){ return true; }
+                                        : +[](const char*, const FQueryOpCode&){ return false; };
+    } else {
+        switch (Code.ValueKind) {
+        case BasicKind::Bool:   Code.Test = PickTest<bool,     int64_t>(Code.Op);  break;
+        case BasicKind::Int8:   Code.Test = PickTest<int8_t,   int64_t>(Code.Op);  break;
+        case BasicKind::Int16:  Code.Test = PickTest<int16_t,  int64_t>(Code.Op);  break;
+        case BasicKind::Int:    Code.Test = PickTest<int32_t,  int64_t>(Code.Op);  break;
+        case BasicKind::Int64:  Code.Test = PickTest<int64_t,  int64_t>(Code.Op);  break;
+        case BasicKind::UInt8:  Code.Test = PickTest<uint8_t,  int64_t>(Code.Op);  break;
+        case BasicKind::UInt16: Code.Test = PickTest<uint16_t, int64_t>(Code.Op);  break;
+        case BasicKind::UInt32: Code.Test = PickTest<uint32_t, int64_t>(Code.Op);  break;
+        case BasicKind::UInt64: Code.Test = PickTest<uint64_t, uint64_t>(Code.Op); break;
+        case BasicKind::Float:  Code.Test = PickTest<float,    float>(Code.Op);    break;
+        case BasicKind::Double: Code.Test = PickTest<double,   double>(Code.Op);   break;
+        default: break;   // ResolveColumn only lets the kinds above through
+        }
+    }
+    Ops.push_back(Code);
+}
+
+bool QObjectQuery::MatchesRow(const char* Row) const
+{
+    for (const FQueryOpCode& Code : Ops)
+        if (!Code.Test(Row, Code)) return false;
+    return true;
+}
+
+unsigned QObjectQuery::PickThreads(std::size_t NumObjects, unsigned NumThreads)
+{
+    if (NumThreads == 0) NumThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (NumObjects < ParallelQueryThreshold) return 1;
+    const std::size_t NumBlocks = (NumObjects + BlockSize - 1) / BlockSize;
+    return static_cast<unsigned>(std::min<std::size_t>(NumThreads, NumBlocks));
+}
+
+template <typename Visitor>
+void QObjectQuery::ForEachBlock(std::span<QObject* const> Objects, unsigned NumThreads, const Visitor& Visit) const
+{
+    auto Worker = [&](unsigned ThreadIndex, std::size_t Begin, std::size_t End){
+        alignas(64) uint16_t Sel[BlockSize];
+        // typeid reads the vtable without a call, so the virtual GetClassInfo only runs when the type changes
+        const std::type_info* LastType = nullptr;
+        bool bLastMatches = false;
+
+        for (std::size_t Block = Begin; Block < End; Block += BlockSize) {
+            const std::size_t n = std::min(BlockSize, End - Block);
+            std::size_t m = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                const QObject* Obj = Objects[Block + i];
+                if (!Obj) continue;
+                const std::type_info* Type = &typeid(*Obj);
+                if (Type != LastType) { LastType = Type; bLastMatches = Obj->GetClassInfo().IsChildOf(*Class); }
+                // every condition read while the row is in cache, stopping at the first that fails
+                if (bLastMatches && MatchesRow(reinterpret_cast<const char*>(Obj))) Sel[m++] = static_cast<uint16_t>(i);
+            }
+            if (m) Visit(ThreadIndex, Block, Objects.data() + Block, Sel, m);
+        }
+    };
+
+    if (NumThreads <= 1) {
+        Worker(0, 0, Objects.size());
+        return;
+    }
+
+    // whole blocks per thread
+    const std::size_t NumBlocks = (Objects.size() + BlockSize - 1) / BlockSize;
+    const std::size_t Chunk = (NumBlocks + NumThreads - 1) / NumThreads * BlockSize;
+    std::vector<std::thread> Threads;
+    for (unsigned t = 0; t < NumThreads; ++t) {
+        const std::size_t Begin = std::min(Objects.size(), t * Chunk);
+        Threads.emplace_back(Worker, t, Begin, std::min(Objects.size(), Begin + Chunk));
+    }
+    for (std::thread& Thread : Threads) Thread.join();
+}
+
+std::size_t QObjectQuery::Count(std::span<QObject* const> Objects, unsigned NumThreads) const
+{
+    if (!bValid) return 0;
+    const unsigned Threads = PickThreads(Objects.size(), NumThreads);
+    std::vector<std::size_t> Partial(Threads, 0);
+    ForEachBlock(Objects, Threads, [&](unsigned t, std::size_t, QObject* const*, const uint16_t*, std::size_t m){
+        Partial[t] += m;
+    });
+
+    std::size_t Total = 0;
+    for (std::size_t Count : Partial) Total += Count;
+    return Total;
+}
+
+void QObjectQuery::Filter(std::span<QObject* const> Objects, std::vector<QObject*>& Out, unsigned NumThreads) const
+{
+    if (!bValid) return;
+    const unsigned Threads = PickThreads(Objects.size(), NumThreads);
+    std::vector<std::vector<QObject*>> Partial(Threads);
+    ForEachBlock(Objects, Threads, [&](unsigned t, std::size_t Begin, QObject* const*, const uint16_t* Sel, std::size_t m){
+        for (std::size_t k = 0; k < m; ++k) Partial[t].push_back(Objects[Begin + Sel[k]]);
+    });
+
+    // threads own consecutive ranges, so concatenating keeps the input order
+    for (const std::vector<QObject*>& Matches : Partial) Out.insert(Out.end(), Matches.begin(), Matches.end());
+}
+
+FQueryAggregate QObjectQuery::Aggregate(std::span<QObject* const> Objects, std::string_view ValuePath, unsigned NumThreads) const
+{
+    FColumnLeaf Value;
+    const bool bCountOnly = ValuePath.empty();
+    if (!bValid || (!bCountOnly && !ResolveColumn(ValuePath, Value, EColumnKinds::Any))) return {};
+
+    const unsigned Threads = PickThreads(Objects.size(), NumThreads);
+    std::vector<FQueryAggregate> Partial(Threads);
+    ForEachBlock(Objects, Threads, [&](unsigned t, std::size_t, QObject* const* Rows, const uint16_t* Sel, std::size_t m){
+        alignas(64) double Values[BlockSize];
+        if (bCountOnly) std::fill(Values, Values + m, 0.0);
+        else            GatherColumn(Rows, Sel, m, Value.Offset, Value.ValueKind, Values);
+        Accumulate(Partial[t], Values, m);
+    });
+
+    FQueryAggregate Result;
+    for (const FQueryAggregate& Part : Partial) Result.Merge(Part);
+    return Result;
+}
+
+template <typename TKey>
+std::map<TKey, FQueryAggregate> QObjectQuery::GroupByKey(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                                         std::string_view ValuePath, unsigned NumThreads) const
+{
+    FColumnLeaf Key, Value;
+    const bool bCountOnly = ValuePath.empty();
+    const EColumnKinds KeyKinds = std::is_signed_v<TKey> ? EColumnKinds::Signed : EColumnKinds::Unsigned;
+    if (!bValid || !ResolveColumn(KeyPath, Key, KeyKinds) || (!bCountOnly && !ResolveColumn(ValuePath, Value, EColumnKinds::Any))) return {};
+
+    const unsigned Threads = PickThreads(Objects.size(), NumThreads);
+    std::vector<std::unordered_map<TKey, FQueryAggregate>> Partial(Threads);
+    ForEachBlock(Objects, Threads, [&](unsigned t, std::size_t, QObject* const* Rows, const uint16_t* Sel, std::size_t m){
+        alignas(64) TKey    Keys[BlockSize];
+        alignas(64) double  Values[BlockSize];
+        GatherColumn(Rows, Sel, m, Key.Offset, Key.ValueKind, Keys);
+        if (bCountOnly) std::fill(Values, Values + m, 0.0);
+        else            GatherColumn(Rows, Sel, m, Value.Offset, Value.ValueKind, Values);
+
+        auto& Groups = Partial[t];
+        for (std::size_t k = 0; k < m; ++k) {
+            FQueryAggregate& Group = Groups[Keys[k]];
+            ++Group.Count;
+            Group.Sum += Values[k];
+            Group.Min = std::min(Group.Min, Values[k]);
+            Group.Max = std::max(Group.Max, Values[k]);
+        }
+    });
+
+    std::map<TKey, FQueryAggregate> Result;
+    for (const auto& Groups : Partial)
+        for (const auto& [GroupKey, Group] : Groups) Result[GroupKey].Merge(Group);
+    return Result;
+}
+
+std::map<int64_t, FQueryAggregate> QObjectQuery::GroupBy(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                                         std::string_view ValuePath, unsigned NumThreads) const
+{
+    return GroupByKey<int64_t>(Objects, KeyPath, ValuePath, NumThreads);
+}
+
+std::map<uint64_t, FQueryAggregate> QObjectQuery::GroupByUnsigned(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                                                  std::string_view ValuePath, unsigned NumThreads) const
+{
+    return GroupByKey<uint64_t>(Objects, KeyPath, ValuePath, NumThreads);
+}
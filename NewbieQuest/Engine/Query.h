@@ -0,0 +1,131 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CoreMinimal.h"
+
+class QObject;
+
+enum class EQueryOp : uint8_t { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+struct FQueryAggregate
+{
+    std::size_t Count = 0;
+    double      Sum = 0.0;
+    double      Min = std::numeric_limits<double>::infinity();
+    double      Max = -std::numeric_limits<double>::infinity();
+
+    double Mean() const { return Count ? Sum / static_cast<double>(Count) : 0.0; }
+    void   Merge(const FQueryAggregate& Other);
+};
+
+// Filter / aggregate over live objects by reflected leaf path, e.g.
+//
+//   QObjectQuery Query(QMonster::StaticClass());
+//   Query.Where("bBoss", EQueryOp::Equal, true).Where("Rage", EQueryOp::Greater, 0.8);
+//   auto ByLevel = Query.GroupBy(Monsters, "Level", "Rage");
+//
+// Conditions are ANDed and compiled once to flat (offset, kind, op, constant) ops, each with
+// a test function specialized for its leaf type and comparison. Every object is tested against
+// the ops in turn while its row is in cache, stopping at the first failure; the matches of each
+// block of objects then feed the aggregation, which reads its key/value leaves for them only.
+// Objects of other classes (and null entries) never match. Large spans are split
+// across threads; NumThreads = 0 picks the hardware concurrency.
+class QObjectQuery
+{
+public:
+    explicit QObjectQuery(const ClassInfo& Info);
+
+    // Path must name a numeric, bool or enum leaf; otherwise the query becomes invalid.
+    // Integer constants are compared exactly, whatever the width and signedness of the leaf.
+    template <typename T>
+    requires (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+    QObjectQuery& Where(std::string_view Path, EQueryOp Op, T Value)
+    {
+        if constexpr (std::is_enum_v<T>) return Where(Path, Op, static_cast<std::underlying_type_t<T>>(Value));
+        else if constexpr (std::is_floating_point_v<T>) return AddCondition(Path, Op, static_cast<double>(Value));
+        else if constexpr (std::is_signed_v<T>) return AddCondition(Path, Op, static_cast<int64_t>(Value));
+        else return AddCondition(Path, Op, static_cast<uint64_t>(Value));
+    }
+
+    bool IsValid() const { return bValid; }
+
+    std::size_t Count(std::span<QObject* const> Objects, unsigned NumThreads = 0) const;
+    // matching objects appended to Out in input order
+    void Filter(std::span<QObject* const> Objects, std::vector<QObject*>& Out, unsigned NumThreads = 0) const;
+
+    // count/sum/min/max of the ValuePath leaf over the matching objects; an empty ValuePath only counts
+    FQueryAggregate Aggregate(std::span<QObject* const> Objects, std::string_view ValuePath, unsigned NumThreads = 0) const;
+    // the same, per distinct value of the integer (or bool / enum) KeyPath leaf; uint64 keys need GroupByUnsigned
+    std::map<int64_t, FQueryAggregate> GroupBy(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                               std::string_view ValuePath, unsigned NumThreads = 0) const;
+    // GroupBy for unsigned (or bool / unsigned-backed enum) KeyPath leaves, uint64 included
+    std::map<uint64_t, FQueryAggregate> GroupByUnsigned(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                                        std::string_view ValuePath, unsigned NumThreads = 0) const;
+
+    // objects evaluated per block; also the column length
+    static constexpr std::size_t BlockSize = 256;
+
+private:
+    // One compiled condition. Integer leaves compare in int64 (uint64 leaves in uint64) with
+    // the constant rounded so the result matches a comparison against the exact value.
+    struct FQueryOpCode;
+    using FRowTest = bool (*)(const char* Row, const FQueryOpCode& Code);
+
+    struct FQueryOpCode
+    {
+        std::size_t Offset = 0;
+        BasicKind   ValueKind = BasicKind::Int;
+        EQueryOp    Op = EQueryOp::Equal;
+        double      FloatConstant = 0.0;
+        int64_t     IntConstant = 0;
+        uint64_t    UIntConstant = 0;
+        bool        bConstantResult = false; // the op is decided by the constant alone...
+        bool        bConstantValue = false;  // ...and always yields this
+        FRowTest    Test = nullptr;
+    };
+
+    struct FColumnLeaf
+    {
+        std::size_t Offset = 0;
+        BasicKind   ValueKind = BasicKind::Int;
+    };
+
+    QObjectQuery& AddCondition(std::string_view Path, EQueryOp Op, double Value);
+    QObjectQuery& AddCondition(std::string_view Path, EQueryOp Op, int64_t Value);
+    QObjectQuery& AddCondition(std::string_view Path, EQueryOp Op, uint64_t Value);
+    // resolves Path into a new op; false (and the query invalid) if it isn't a comparable leaf
+    bool BeginCondition(std::string_view Path, EQueryOp Op, FQueryOpCode& Code);
+    // picks Code.Test and appends the op
+    void FinishCondition(FQueryOpCode& Code);
+
+    template <typename TStored, typename TCompare, EQueryOp Op>
+    static bool TestLeaf(const char* Row, const FQueryOpCode& Code);
+    template <typename TStored, typename TCompare>
+    static FRowTest PickTest(EQueryOp Op);
+
+    enum class EColumnKinds : uint8_t { Any, Integer, Signed, Unsigned };
+    bool ResolveColumn(std::string_view Path, FColumnLeaf& Out, EColumnKinds Kinds) const;
+
+    template <typename TKey>
+    std::map<TKey, FQueryAggregate> GroupByKey(std::span<QObject* const> Objects, std::string_view KeyPath,
+                                               std::string_view ValuePath, unsigned NumThreads) const;
+
+    // Row (an object of the class) passes every op
+    bool MatchesRow(const char* Row) const;
+
+    static unsigned PickThreads(std::size_t NumObjects, unsigned NumThreads);
+
+    // Visit(ThreadIndex, BeginIndex, Rows, Sel, m) for every block with m > 0 matches at Rows[Sel[k]];
+    // each thread visits its blocks in order
+    template <typename Visitor>
+    void ForEachBlock(std::span<QObject* const> Objects, unsigned NumThreads, const Visitor& Visit) const;
+
+    const ClassInfo* Class;
+    std::vector<FQueryOpCode> Ops;
+    bool bValid = true;
+};
@@ -0,0 +1,374 @@
+#include "SharedAssetCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "CoreTypes/Object.h"
+#include "Engine/Trace.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Segment layout, all fields in host byte order (the segment never leaves the machine):
+//  [64]               FHeader
+//  [48 x NumSlots]    FSlot, open addressing with linear probing
+//  [ArenaSize]        value blocks, 8-byte aligned
+//
+// Value block:
+//  [4] KeyLength  [4] ClassNameLength  [4] ObjectNameLength  [4] LeafCount
+//  [N] Key, ClassName, ObjectName
+//  per leaf in leaf order: its raw bytes (Leaf.Size), or for a string [4] Offset [4] Length
+//  [N] string bytes, Offset is from the start of the block
+struct QSharedAssetCache::FHeader
+{
+    uint32_t Magic;        // written last by the creator; openers wait for it
+    uint32_t Version;
+    uint64_t NumSlots;
+    uint64_t ArenaSize;
+    uint64_t ArenaUsed;    // bump pointer, may run past ArenaSize once the arena is full
+    uint8_t  Reserved[32];
+};
+
+struct QSharedAssetCache::FSlot
+{
+    uint64_t KeyHash;      // 0 = free; claimed with a CAS
+    uint32_t State;        // ESlotState, the rest of the slot is valid once it reads Ready
+    uint32_t Reserved;
+    uint64_t SchemaHash;
+    uint64_t AssetVersion; // entries of an older version of the asset stay but never match
+    uint64_t Offset;       // into the arena
+    uint64_t Size;
+};
+
+namespace
+{
+    constexpr uint32_t SharedCacheMagic = 0x43415351;   // "QSAC"
+    constexpr uint32_t SharedCacheVersion = 2;
+    constexpr std::size_t BlockHeaderSize = 16;
+    constexpr std::size_t StringRefSize = 8;
+    constexpr auto OpenTimeout = std::chrono::seconds(2);
+
+    enum ESlotState : uint32_t { SlotPending = 0, SlotReady = 1, SlotFailed = 2 };
+
+    static_assert(std::atomic_ref<uint64_t>::is_always_lock_free && std::atomic_ref<uint32_t>::is_always_lock_free,
+                  "shared-memory atomics must be lock free");
+
+    template <typename T>
+    T LoadAcquire(T& Field) { return std::atomic_ref<T>(Field).load(std::memory_order_acquire); }
+
+    template <typename T>
+    void StoreRelease(T& Field, T Value) { std::atomic_ref<T>(Field).store(Value, std::memory_order_release); }
+
+    std::size_t SegmentSize(std::size_t NumSlots, std::size_t ArenaSize)
+    {
+        return 64 + NumSlots * 48 + ArenaSize;
+    }
+
+    std::size_t RoundUpPow2(std::size_t n)
+    {
+        std::size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    uint32_t LoadU32(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    void     StoreU32(uint8_t* p, uint32_t v) { std::memcpy(p, &v, 4); }
+
+    // openers may map the segment between its creation and its initialization
+    bool WaitForHeader(uint32_t& Magic)
+    {
+        const auto Deadline = std::chrono::steady_clock::now() + OpenTimeout;
+        while (LoadAcquire(Magic) != SharedCacheMagic) {
+            if (std::chrono::steady_clock::now() > Deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+QSharedAssetCache::~QSharedAssetCache()
+{
+    Close();
+}
+
+QSharedAssetCache::FSlot* QSharedAssetCache::Slots() const
+{
+    return reinterpret_cast<FSlot*>(Base + sizeof(FHeader));
+}
+
+uint8_t* QSharedAssetCache::Arena() const
+{
+    return Base + sizeof(FHeader) + Header()->NumSlots * sizeof(FSlot);
+}
+
+uint64_t QSharedAssetCache::HashKey(std::string_view Key)
+{
+    const uint64_t Hash = Fnv1a64(Key.data(), Key.size());
+    return Hash ? Hash : 1;   // 0 marks a free slot
+}
+
+bool QSharedAssetCache::Open(const std::string& Name, std::size_t NumSlots, std::size_t ArenaSize)
+{
+    static_assert(sizeof(FHeader) == 64 && sizeof(FSlot) == 48, "SegmentSize assumes these sizes");
+    Close();
+    QTRACE_ZONE("SharedCacheOpen", Name);
+    NumSlots = RoundUpPow2(std::max<std::size_t>(NumSlots, 16));
+    ArenaSize = (ArenaSize + 7) & ~std::size_t(7);
+    const std::size_t Size = SegmentSize(NumSlots, ArenaSize);
+    bool bCreator = false;
+
+#ifdef _WIN32
+    const std::string MappingName = Name.starts_with('/') ? Name.substr(1) : Name;
+    HANDLE Handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(uint64_t(Size) >> 32), static_cast<DWORD>(Size),
+                                       MappingName.c_str());
+    if (!Handle) return false;
+    bCreator = GetLastError() != ERROR_ALREADY_EXISTS;
+    void* View = MapViewOfFile(Handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!View) { CloseHandle(Handle); return false; }
+    MEMORY_BASIC_INFORMATION Region{};
+    VirtualQuery(View, &Region, sizeof(Region));
+    Mapping = Handle;
+    Base = static_cast<uint8_t*>(View);
+    MappedSize = bCreator ? Size : Region.RegionSize;
+#else
+    int Fd = shm_open(Name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (Fd >= 0) {
+        bCreator = true;
+        if (ftruncate(Fd, static_cast<off_t>(Size)) != 0) { close(Fd); shm_unlink(Name.c_str()); return false; }
+    } else {
+        if (errno != EEXIST) return false;
+        Fd = shm_open(Name.c_str(), O_RDWR, 0);
+        if (Fd < 0) return false;
+    }
+
+    // the creator sizes the segment right after creating it
+    struct stat Stat{};
+    const auto Deadline = std::chrono::steady_clock::now() + OpenTimeout;
+    while (fstat(Fd, &Stat) == 0 && Stat.st_size == 0 && std::chrono::steady_clock::now() < Deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (Stat.st_size < static_cast<off_t>(sizeof(FHeader))) { close(Fd); return false; }
+
+    void* View = mmap(nullptr, static_cast<std::size_t>(Stat.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    close(Fd);
+    if (View == MAP_FAILED) return false;
+    Base = static_cast<uint8_t*>(View);
+    MappedSize = static_cast<std::size_t>(Stat.st_size);
+#endif
+
+    // new pages are zeroed: every slot is already free
+    FHeader& H = *Header();
+    if (bCreator) {
+        H.Version = SharedCacheVersion;
+        H.NumSlots = NumSlots;
+        H.ArenaSize = ArenaSize;
+        StoreRelease(H.Magic, SharedCacheMagic);
+        return true;
+    }
+    if (!WaitForHeader(H.Magic) || H.Version != SharedCacheVersion
+        || (H.NumSlots & (H.NumSlots - 1)) != 0 || SegmentSize(H.NumSlots, H.ArenaSize) > MappedSize) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void QSharedAssetCache::Close()
+{
+    if (!Base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(Base);
+    CloseHandle(Mapping);
+    Mapping = nullptr;
+#else
+    munmap(Base, MappedSize);
+#endif
+    Base = nullptr;
+    MappedSize = 0;
+}
+
+bool QSharedAssetCache::Remove(const std::string& Name)
+{
+#ifdef _WIN32
+    (void)Name;
+    return true;   // the mapping goes away with its last handle
+#else
+    return shm_unlink(Name.c_str()) == 0;
+#endif
+}
+
+const QSharedAssetCache::FSlot* QSharedAssetCache::FindReady(std::string_view Key, uint64_t KeyHash, uint64_t Version) const
+{
+    const uint64_t Mask = Header()->NumSlots - 1;
+    FSlot* Table = Slots();
+    for (uint64_t Probe = 0, i = KeyHash & Mask; Probe <= Mask; ++Probe, i = (i + 1) & Mask) {
+        FSlot& Slot = Table[i];
+        const uint64_t Hash = LoadAcquire(Slot.KeyHash);
+        if (Hash == 0) return nullptr;          // end of the probe chain
+        if (Hash != KeyHash) continue;
+        const uint32_t State = LoadAcquire(Slot.State);
+        if (State == SlotPending) return nullptr;  // still being written; can't tell whose it is yet
+        if (State != SlotReady || Slot.AssetVersion != Version) continue;
+
+        const uint8_t* Block = Arena() + Slot.Offset;
+        if (LoadU32(Block) == Key.size() && std::memcmp(Block + BlockHeaderSize, Key.data(), Key.size()) == 0)
+            return &Slot;
+    }
+    return nullptr;
+}
+
+std::unique_ptr<QObject> QSharedAssetCache::Build(std::string_view Key, uint64_t Version) const
+{
+    if (!Base) return nullptr;
+    const FSlot* Slot = FindReady(Key, HashKey(Key), Version);
+    if (!Slot) return nullptr;
+
+    const uint8_t* Block = Arena() + Slot->Offset;
+    const uint32_t KeyLength = LoadU32(Block);
+    const uint32_t ClassNameLength = LoadU32(Block + 4);
+    const uint32_t ObjectNameLength = LoadU32(Block + 8);
+    const uint32_t LeafCount = LoadU32(Block + 12);
+    const char* Names = reinterpret_cast<const char*>(Block + BlockHeaderSize);
+    const std::string ClassName(Names + KeyLength, ClassNameLength);
+
+    const ClassInfo* Info = Registry::Get().Find(ClassName);
+    if (!Info || !Info->Factory || Info->GetSchemaHash() != Slot->SchemaHash) return nullptr;
+    const std::vector<LeafInfo>& Leaves = Info->GetLeaves();
+    if (Leaves.size() != LeafCount) return nullptr;
+
+    QTRACE_ZONE("SharedCacheBuild", Key, ClassName);
+    std::unique_ptr<QObject> Obj = Info->Factory();
+    Obj->SetObjectName(std::string(Names + KeyLength + ClassNameLength, ObjectNameLength));
+
+    const uint8_t* Value = Block + BlockHeaderSize + KeyLength + ClassNameLength + ObjectNameLength;
+    for (const LeafInfo& Leaf : Leaves) {
+        if (Leaf.Kind == BasicKind::String) {
+            const char* Chars = reinterpret_cast<const char*>(Block + LoadU32(Value));
+            reinterpret_cast<std::string*>(Leaf.Ptr(*Obj))->assign(Chars, LoadU32(Value + 4));
+            Value += StringRefSize;
+        } else {
+            std::memcpy(Leaf.Ptr(*Obj), Value, Leaf.Size);
+            Value += Leaf.Size;
+        }
+    }
+    return Obj;
+}
+
+std::size_t QSharedAssetCache::ValueBlockSize(const QObject& Obj)
+{
+    const ClassInfo& Info = Obj.GetClassInfo();
+    std::size_t Size = BlockHeaderSize + Info.Name.size() + Obj.GetObjectName().size();
+    for (const LeafInfo& Leaf : Info.GetLeaves()) {
+        if (Leaf.Kind == BasicKind::String)
+            Size += StringRefSize + reinterpret_cast<const std::string*>(Leaf.ConstPtr(Obj))->size();
+        else
+            Size += Leaf.Size;
+    }
+    return Size;
+}
+
+bool QSharedAssetCache::Publish(std::string_view Key, uint64_t Version, const QObject& Obj)
+{
+    if (!Base) return false;
+    const ClassInfo& Info = Obj.GetClassInfo();
+    const uint64_t KeyHash = HashKey(Key);
+    const uint64_t Mask = Header()->NumSlots - 1;
+    FSlot* Table = Slots();
+
+    // claim a free slot, unless this version of the key is already there (or on its way)
+    FSlot* Claimed = nullptr;
+    for (uint64_t Probe = 0, i = KeyHash & Mask; Probe <= Mask && !Claimed; ++Probe, i = (i + 1) & Mask) {
+        FSlot& Slot = Table[i];
+        uint64_t Hash = LoadAcquire(Slot.KeyHash);
+        if (Hash == 0) {
+            if (std::atomic_ref<uint64_t>(Slot.KeyHash).compare_exchange_strong(Hash, KeyHash, std::memory_order_acq_rel)) {
+                Claimed = &Slot;
+                break;
+            }
+            // lost the race; Hash now holds the winner's key
+        }
+        if (Hash != KeyHash) continue;
+        const uint32_t State = LoadAcquire(Slot.State);
+        if (State == SlotPending) return false;
+        if (Slot.AssetVersion != Version) continue;   // a stale entry of the key
+        if (State != SlotReady) return false;
+        const uint8_t* Block = Arena() + Slot.Offset;
+        if (LoadU32(Block) == Key.size() && std::memcmp(Block + BlockHeaderSize, Key.data(), Key.size()) == 0)
+            return false;
+    }
+    if (!Claimed) return false;
+    Claimed->AssetVersion = Version;   // published with the state, Ready or Failed
+
+    QTRACE_ZONE("SharedCachePublish", Key, Info.Name);
+    // string refs are 32-bit offsets into the block
+    const std::size_t BlockSize = ValueBlockSize(Obj) + Key.size();
+    if (BlockSize > UINT32_MAX) { StoreRelease(Claimed->State, uint32_t(SlotFailed)); return false; }
+    const uint64_t Offset = std::atomic_ref<uint64_t>(Header()->ArenaUsed).fetch_add((BlockSize + 7) & ~std::size_t(7),
+                                                                                      std::memory_order_relaxed);
+    if (Offset + BlockSize > Header()->ArenaSize) {
+        StoreRelease(Claimed->State, uint32_t(SlotFailed));
+        return false;
+    }
+
+    uint8_t* Block = Arena() + Offset;
+    const std::vector<LeafInfo>& Leaves = Info.GetLeaves();
+    const std::string& ObjectName = Obj.GetObjectName();
+    StoreU32(Block, static_cast<uint32_t>(Key.size()));
+    StoreU32(Block + 4, static_cast<uint32_t>(Info.Name.size()));
+    StoreU32(Block + 8, static_cast<uint32_t>(ObjectName.size()));
+    StoreU32(Block + 12, static_cast<uint32_t>(Leaves.size()));
+    uint8_t* Out = Block + BlockHeaderSize;
+    std::memcpy(Out, Key.data(), Key.size());                 Out += Key.size();
+    std::memcpy(Out, Info.Name.data(), Info.Name.size());     Out += Info.Name.size();
+    std::memcpy(Out, ObjectName.data(), ObjectName.size());   Out += ObjectName.size();
+
+    std::size_t Values = 0;
+    for (const LeafInfo& Leaf : Leaves) Values += Leaf.Kind == BasicKind::String ? StringRefSize : Leaf.Size;
+    uint8_t* Tail = Out + Values;
+    for (const LeafInfo& Leaf : Leaves) {
+        if (Leaf.Kind == BasicKind::String) {
+            const std::string& s = *reinterpret_cast<const std::string*>(Leaf.ConstPtr(Obj));
+            StoreU32(Out, static_cast<uint32_t>(Tail - Block));
+            StoreU32(Out + 4, static_cast<uint32_t>(s.size()));
+            std::memcpy(Tail, s.data(), s.size());
+            Tail += s.size();
+            Out += StringRefSize;
+        } else {
+            std::memcpy(Out, Leaf.ConstPtr(Obj), Leaf.Size);
+            Out += Leaf.Size;
+        }
+    }
+
+    Claimed->SchemaHash = Info.GetSchemaHash();
+    Claimed->Offset = Offset;
+    Claimed->Size = BlockSize;
+    StoreRelease(Claimed->State, uint32_t(SlotReady));
+    return true;
+}
+
+FSharedCacheStats QSharedAssetCache::GetStats() const
+{
+    FSharedCacheStats Stats;
+    if (!Base) return Stats;
+    Stats.NumSlots = Header()->NumSlots;
+    Stats.ArenaSize = Header()->ArenaSize;
+    Stats.ArenaUsed = std::min<std::size_t>(LoadAcquire(Header()->ArenaUsed), Stats.ArenaSize);
+    for (std::size_t i = 0; i < Stats.NumSlots; ++i) {
+        FSlot& Slot = Slots()[i];
+        if (LoadAcquire(Slot.KeyHash) == 0) continue;
+        const uint32_t State = LoadAcquire(Slot.State);
+        Stats.NumReady += State == SlotReady;
+        Stats.NumFailed += State == SlotFailed;
+    }
+    return Stats;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "CoreMinimal.h"
+
+class QObject;
+
+struct FSharedCacheStats
+{
+    std::size_t NumSlots = 0;
+    std::size_t NumReady = 0;     // published entries
+    std::size_t NumFailed = 0;    // claimed but out of arena space
+    std::size_t ArenaSize = 0;
+    std::size_t ArenaUsed = 0;
+};
+
+// Cross-process cache of decoded binary assets in a named shared-memory segment
+// (POSIX shm_open + mmap, a named file mapping on Windows).
+//
+// Entries are write-once: the first process to miss claims the asset's slot with a CAS on
+// the key hash, bump-allocates its value block from the arena, copies it in and releases
+// the slot as Ready. Readers only ever look at Ready slots, so there are no locks and no
+// retries. A slot some other process is still writing counts as a miss.
+//
+// Staleness: an entry is never updated in place. Each one carries the asset version it was
+// built from (QAssetManager uses the file's size and mtime), and Build() only returns an
+// entry whose version matches the caller's, so a rewritten asset misses and is published
+// again next to the stale entry, which keeps its slot and arena space until Remove().
+// The key must identify the file itself (QAssetManager uses its absolute path), so
+// processes with different asset roots never serve each other's assets. A rewrite that
+// keeps both the size and the mtime (coarse timestamps) goes unnoticed.
+//
+// A value block holds the object name and every leaf of the class in leaf order: plain
+// leaves as their raw bytes, strings as an (offset, length) pair into the block's tail.
+// Build() creates the object and copies the leaves straight out of the segment. Each
+// entry keeps the class' schema hash; a process whose class has a different schema
+// (another build) treats the entry as a miss and never publishes over it.
+//
+// The segment lives until Remove() (or a reboot), so all processes must agree on its
+// size. A crash mid-publish leaves that one slot unusable until the segment is removed.
+class QSharedAssetCache
+{
+public:
+    QSharedAssetCache() = default;
+    ~QSharedAssetCache();
+
+    QSharedAssetCache(const QSharedAssetCache&) = delete;
+    QSharedAssetCache& operator=(const QSharedAssetCache&) = delete;
+
+    // Creates the segment, or maps the existing one (whose own slot count and arena size win).
+    // Name is a POSIX shm name ("/NewbieQuestAssets"); NumSlots is rounded up to a power of two.
+    bool Open(const std::string& Name, std::size_t NumSlots = 4096, std::size_t ArenaSize = 64u << 20);
+    void Close();
+    bool IsOpen() const { return Base != nullptr; }
+
+    // unlinks the segment; processes that still map it keep their view
+    static bool Remove(const std::string& Name);
+
+    // a new object built from the Ready entry for Key at Version, or null
+    std::unique_ptr<QObject> Build(std::string_view Key, uint64_t Version) const;
+
+    // Publishes Obj under Key at Version unless some process already claimed that pair.
+    // Returns false if it is taken, the table is full or the arena ran out.
+    bool Publish(std::string_view Key, uint64_t Version, const QObject& Obj);
+
+    FSharedCacheStats GetStats() const;
+
+private:
+    struct FHeader;
+    struct FSlot;
+
+    FHeader* Header() const { return reinterpret_cast<FHeader*>(Base); }
+    FSlot*   Slots() const;
+    uint8_t* Arena() const;
+
+    // Ready slot for Key at Version, or null
+    const FSlot* FindReady(std::string_view Key, uint64_t KeyHash, uint64_t Version) const;
+
+    static uint64_t HashKey(std::string_view Key);
+    static std::size_t ValueBlockSize(const QObject& Obj);
+
+    uint8_t*    Base = nullptr;
+    std::size_t MappedSize = 0;
+#ifdef _WIN32
+    void*       Mapping = nullptr;
+#endif
+};
@@ -0,0 +1,263 @@
+#include "Snapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "Object.h"
+
+namespace
+{
+    constexpr uint32_t SnapshotMagic = 'Q' | ('S' << 8) | ('N' << 16) | ('P' << 24);
+    constexpr uint32_t DeltaMagic    = 'Q' | ('S' << 8) | ('N' << 16) | ('D' << 24);
+
+    uint32_t BitsFor(std::size_t Count)
+    {
+        uint32_t Bits = 0;
+        while (Bits < 32 && (std::size_t(1) << Bits) < Count) ++Bits;
+        return Bits;
+    }
+}
+
+const std::vector<QSnapshotEncoder::FQuantizedLeaf>& QSnapshotEncoder::GetLayout(const ClassInfo& Info)
+{
+    auto It = Layouts.find(&Info);
+    if (It != Layouts.end()) return It->second;
+
+    std::vector<FQuantizedLeaf> Layout;
+    for (const LeafInfo& Leaf : Info.GetLeaves()) {
+        FQuantizedLeaf Q;
+        Q.Offset = Leaf.Offset;
+        Q.Kind = Leaf.ValueKind;
+        Q.bRanged = Leaf.Meta.bRanged && Leaf.Meta.Bits > 0 && Leaf.Meta.Max > Leaf.Meta.Min;
+        switch (Q.Kind) {
+        case BasicKind::Bool:   Q.Bits = 1; Q.bRanged = false; break;
+        case BasicKind::String: Q.Bits = 0; Q.bRanged = false; break;
+        case BasicKind::Struct: throw std::runtime_error("non-primitive leaf");
+        default: {
+            const uint32_t Natural = static_cast<uint32_t>(KindSize(Q.Kind) * 8);
+            Q.Bits = Q.bRanged ? std::min<uint32_t>(Leaf.Meta.Bits, Natural) : Natural;
+            break;
+        }
+        }
+        if (Q.bRanged) {
+            Q.Min = Leaf.Meta.Min;
+            Q.Max = Leaf.Meta.Max;
+            const double MaxCode = static_cast<double>((uint64_t(1) << Q.Bits) - 1);
+            // integers keep unit steps and only drop the offset; floats spread the codes over the range
+            Q.Scale    = IsIntegerKind(Q.Kind) ? 1.0 : MaxCode / (Q.Max - Q.Min);
+            Q.InvScale = 1.0 / Q.Scale;
+        }
+        Layout.push_back(Q);
+    }
+    return Layouts.emplace(&Info, std::move(Layout)).first->second;
+}
+
+uint64_t QSnapshotEncoder::Quantize(const FQuantizedLeaf& Leaf, const QObject& Obj)
+{
+    const char* Ptr = reinterpret_cast<const char*>(&Obj) + Leaf.Offset;
+    switch (Leaf.Kind) {
+    case BasicKind::Bool:
+        return *reinterpret_cast<const bool*>(Ptr) ? 1u : 0u;
+    case BasicKind::Float: {
+        const float v = *reinterpret_cast<const float*>(Ptr);
+        if (!Leaf.bRanged) { uint32_t u; std::memcpy(&u, &v, 4); return u; }
+        const double Clamped = std::isnan(v) ? Leaf.Min : std::clamp(static_cast<double>(v), Leaf.Min, Leaf.Max);
+        return static_cast<uint64_t>(std::llround((Clamped - Leaf.Min) * Leaf.Scale));
+    }
+    case BasicKind::Double: {
+        const double v = *reinterpret_cast<const double*>(Ptr);
+        if (!Leaf.bRanged) { uint64_t u; std::memcpy(&u, &v, 8); return u; }
+        const double Clamped = std::isnan(v) ? Leaf.Min : std::clamp(v, Leaf.Min, Leaf.Max);
+        return static_cast<uint64_t>(std::llround((Clamped - Leaf.Min) * Leaf.Scale));
+    }
+    case BasicKind::String:
+        return 0;
+    default: {
+        const int64_t v = LoadInteger(Ptr, Leaf.Kind);
+        if (!Leaf.bRanged) {
+            // drop the sign extension so the code fits the natural width
+            return Leaf.Bits >= 64 ? static_cast<uint64_t>(v) : static_cast<uint64_t>(v) & ((uint64_t(1) << Leaf.Bits) - 1);
+        }
+        const double Value = IsUnsignedIntegerKind(Leaf.Kind) ? static_cast<double>(static_cast<uint64_t>(v)) : static_cast<double>(v);
+        const double Clamped = std::clamp(Value, Leaf.Min, Leaf.Max);
+        const uint64_t MaxCode = (uint64_t(1) << Leaf.Bits) - 1;
+        return std::min<uint64_t>(static_cast<uint64_t>(Clamped - Leaf.Min), MaxCode);
+    }
+    }
+}
+
+void QSnapshotEncoder::Dequantize(const FQuantizedLeaf& Leaf, uint64_t Code, QObject& Obj)
+{
+    char* Ptr = reinterpret_cast<char*>(&Obj) + Leaf.Offset;
+    switch (Leaf.Kind) {
+    case BasicKind::Bool:
+        *reinterpret_cast<bool*>(Ptr) = Code != 0;
+        break;
+    case BasicKind::Float:
+        if (Leaf.bRanged) {
+            *reinterpret_cast<float*>(Ptr) = static_cast<float>(Leaf.Min + static_cast<double>(Code) * Leaf.InvScale);
+        } else {
+            const uint32_t u = static_cast<uint32_t>(Code);
+            std::memcpy(Ptr, &u, 4);
+        }
+        break;
+    case BasicKind::Double:
+        if (Leaf.bRanged) {
+            *reinterpret_cast<double*>(Ptr) = Leaf.Min + static_cast<double>(Code) * Leaf.InvScale;
+        } else {
+            std::memcpy(Ptr, &Code, 8);
+        }
+        break;
+    case BasicKind::String:
+        break;
+    default:
+        // StoreInteger truncates to the kind's width, which restores the sign of unranged codes
+        StoreInteger(Ptr, Leaf.Kind, Leaf.bRanged
+            ? static_cast<int64_t>(std::llround(Leaf.Min)) + static_cast<int64_t>(Code)
+            : static_cast<int64_t>(Code));
+        break;
+    }
+}
+
+void QSnapshotEncoder::WriteLeaf(const FQuantizedLeaf& Leaf, const QObject& Obj, FBitWriter& Writer)
+{
+    if (Leaf.Kind == BasicKind::String) Writer.WriteString(StringAt(Leaf, Obj));
+    else                                Writer.WriteBits64(Quantize(Leaf, Obj), Leaf.Bits);
+}
+
+void QSnapshotEncoder::ReadLeaf(const FQuantizedLeaf& Leaf, FBitReader& Reader, QObject& Obj)
+{
+    if (Leaf.Kind == BasicKind::String) {
+        std::string Value;
+        if (Reader.ReadString(Value)) StringAt(Leaf, Obj) = std::move(Value);
+    } else {
+        Dequantize(Leaf, Reader.ReadBits64(Leaf.Bits), Obj);
+    }
+}
+
+void QSnapshotEncoder::EncodeSnapshot(std::span<const QObject* const> Objects, FBitWriter& Writer)
+{
+    // class table: each class name is written once per snapshot
+    std::vector<const ClassInfo*> Classes;
+    std::unordered_map<const ClassInfo*, uint32_t> ClassIndex;
+    for (const QObject* Obj : Objects) {
+        const ClassInfo* Info = &Obj->GetClassInfo();
+        if (ClassIndex.emplace(Info, static_cast<uint32_t>(Classes.size())).second) Classes.push_back(Info);
+    }
+
+    Writer.WriteBits(SnapshotMagic, 32);
+    Writer.WriteVarUInt(Classes.size());
+    for (const ClassInfo* Info : Classes) Writer.WriteString(Info->Name);
+    Writer.WriteVarUInt(Objects.size());
+
+    const uint32_t ClassBits = BitsFor(Classes.size());
+    const ClassInfo* LastInfo = nullptr;
+    const std::vector<FQuantizedLeaf>* Layout = nullptr;
+    uint32_t Index = 0;
+
+    for (const QObject* Obj : Objects) {
+        const ClassInfo* Info = &Obj->GetClassInfo();
+        if (Info != LastInfo) {
+            LastInfo = Info;
+            Layout = &GetLayout(*Info);
+            Index = ClassIndex[Info];
+        }
+        Writer.WriteBits(Index, ClassBits);
+        Writer.WriteString(Obj->GetObjectName());
+        for (const FQuantizedLeaf& Leaf : *Layout) WriteLeaf(Leaf, *Obj, Writer);
+    }
+}
+
+bool QSnapshotEncoder::DecodeSnapshot(std::span<const uint8_t> Bytes, std::vector<std::unique_ptr<QObject>>& OutObjects)
+{
+    FBitReader Reader(Bytes);
+    if (Reader.ReadBits(32) != SnapshotMagic) return false;
+
+    const uint64_t ClassCount = Reader.ReadVarUInt();
+    if (Reader.IsError() || ClassCount > Bytes.size()) return false;
+
+    std::vector<const ClassInfo*> Classes;
+    for (uint64_t i = 0; i < ClassCount; ++i) {
+        std::string ClassName;
+        if (!Reader.ReadString(ClassName)) return false;
+        const ClassInfo* Info = Registry::Get().Find(ClassName);
+        if (!Info || !Info->Factory) return false;
+        Classes.push_back(Info);
+    }
+
+    const uint64_t ObjectCount = Reader.ReadVarUInt();
+    if (Reader.IsError() || ObjectCount > Bytes.size() * 8) return false;
+
+    const uint32_t ClassBits = BitsFor(Classes.size());
+    OutObjects.reserve(OutObjects.size() + static_cast<std::size_t>(ObjectCount));
+
+    for (uint64_t i = 0; i < ObjectCount; ++i) {
+        const uint32_t Index = Reader.ReadBits(ClassBits);
+        if (Index >= Classes.size()) return false;
+        const ClassInfo& Info = *Classes[Index];
+
+        std::unique_ptr<QObject> Obj = Info.Factory();
+        std::string ObjectName;
+        if (!Reader.ReadString(ObjectName)) return false;
+        Obj->SetObjectName(std::move(ObjectName));
+
+        for (const FQuantizedLeaf& Leaf : GetLayout(Info)) ReadLeaf(Leaf, Reader, *Obj);
+        if (Reader.IsError()) return false;
+        OutObjects.push_back(std::move(Obj));
+    }
+    return true;
+}
+
+bool QSnapshotEncoder::EncodeDelta(std::span<const QObject* const> Baseline, std::span<const QObject* const> Current, FBitWriter& Writer)
+{
+    if (Baseline.size() != Current.size()) return false;
+
+    Writer.WriteBits(DeltaMagic, 32);
+    Writer.WriteVarUInt(Current.size());
+
+    std::vector<uint64_t> Xor;
+    for (std::size_t i = 0; i < Current.size(); ++i) {
+        const QObject& Base = *Baseline[i];
+        const QObject& Obj = *Current[i];
+        if (&Base.GetClassInfo() != &Obj.GetClassInfo()) return false;
+
+        const std::vector<FQuantizedLeaf>& Layout = GetLayout(Obj.GetClassInfo());
+        Xor.resize(Layout.size());
+        bool bChanged = false;
+        for (std::size_t l = 0; l < Layout.size(); ++l) {
+            Xor[l] = Layout[l].Kind == BasicKind::String
+                ? (StringAt(Layout[l], Base) != StringAt(Layout[l], Obj) ? 1u : 0u)
+                : Quantize(Layout[l], Base) ^ Quantize(Layout[l], Obj);
+            bChanged |= Xor[l] != 0;
+        }
+
+        Writer.WriteBool(bChanged);
+        if (!bChanged) continue;
+        for (std::size_t l = 0; l < Layout.size(); ++l) {
+            Writer.WriteBool(Xor[l] != 0);
+            if (Xor[l] == 0) continue;
+            if (Layout[l].Kind == BasicKind::String) Writer.WriteString(StringAt(Layout[l], Obj));
+            else                                     Writer.WriteBits64(Xor[l], Layout[l].Bits);
+        }
+    }
+    return true;
+}
+
+bool QSnapshotEncoder::ApplyDelta(std::span<const uint8_t> Bytes, std::span<QObject* const> Objects)
+{
+    FBitReader Reader(Bytes);
+    if (Reader.ReadBits(32) != DeltaMagic) return false;
+    if (Reader.ReadVarUInt() != Objects.size() || Reader.IsError()) return false;
+
+    for (QObject* Obj : Objects) {
+        if (!Reader.ReadBool()) continue;
+        for (const FQuantizedLeaf& Leaf : GetLayout(Obj->GetClassInfo())) {
+            if (!Reader.ReadBool()) continue;
+            if (Leaf.Kind == BasicKind::String) { ReadLeaf(Leaf, Reader, *Obj); continue; }
+            // the baseline re-quantizes to the code the encoder XORed against
+            const uint64_t Code = Quantize(Leaf, *Obj) ^ Reader.ReadBits64(Leaf.Bits);
+            Dequantize(Leaf, Code, *Obj);
+        }
+        if (Reader.IsError()) return false;
+    }
+    return true;
+}
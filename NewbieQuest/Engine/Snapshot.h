@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "CoreMinimal.h"
+#include "Engine/BitStream.h"
+
+class QObject;
+
+// Bit-packed snapshots of reflected objects for replays, rollback and local sync.
+// Leaves with PropertyMeta ranges are quantized (QFIELD_RANGE / QFIELD_STEP),
+// bools take a single bit and property names are never written. Other numbers use
+// their natural width; enums with a Count enumerator are packed into just enough bits.
+// Strings are written whole (varint length + bytes).
+//
+// full snapshot:
+//  [32]  Magic "QSNP"
+//  [var] ClassCount, then ClassCount class names
+//  [var] ObjectCount
+//  repeat ObjectCount:
+//     [k]   ClassIndex (k = bits needed for ClassCount)
+//     [var] ObjectName
+//     leaf values in ClassInfo::GetLeaves() order
+//
+// delta snapshot (same objects, same order as the baseline):
+//  [32]  Magic "QSND"
+//  [var] ObjectCount
+//  repeat ObjectCount:
+//     [1] Changed
+//     if changed, per leaf: [1] LeafChanged, then the XOR of the quantized values
+//     (the new value for strings)
+class QSnapshotEncoder
+{
+public:
+    void EncodeSnapshot(std::span<const QObject* const> Objects, FBitWriter& Writer);
+    bool DecodeSnapshot(std::span<const uint8_t> Bytes, std::vector<std::unique_ptr<QObject>>& OutObjects);
+
+    // false if Baseline and Current don't pair up by class
+    bool EncodeDelta(std::span<const QObject* const> Baseline, std::span<const QObject* const> Current, FBitWriter& Writer);
+    // Objects must hold the baseline state; they are updated in place
+    bool ApplyDelta(std::span<const uint8_t> Bytes, std::span<QObject* const> Objects);
+
+private:
+    struct FQuantizedLeaf
+    {
+        std::size_t Offset = 0;
+        BasicKind   Kind;           // storage kind, enums use their underlying integer kind
+        uint32_t    Bits = 0;
+        bool        bRanged = false;
+        double      Min = 0.0;
+        double      Max = 0.0;
+        double      Scale = 1.0;    // quantized steps per unit
+        double      InvScale = 1.0;
+    };
+
+    const std::vector<FQuantizedLeaf>& GetLayout(const ClassInfo& Info);
+
+    static uint64_t Quantize(const FQuantizedLeaf& Leaf, const QObject& Obj);
+    static void     Dequantize(const FQuantizedLeaf& Leaf, uint64_t Code, QObject& Obj);
+
+    static void WriteLeaf(const FQuantizedLeaf& Leaf, const QObject& Obj, FBitWriter& Writer);
+    static void ReadLeaf(const FQuantizedLeaf& Leaf, FBitReader& Reader, QObject& Obj);
+    static const std::string& StringAt(const FQuantizedLeaf& Leaf, const QObject& Obj)
+    {
+        return *reinterpret_cast<const std::string*>(reinterpret_cast<const char*>(&Obj) + Leaf.Offset);
+    }
+    static std::string& StringAt(const FQuantizedLeaf& Leaf, QObject& Obj)
+    {
+        return *reinterpret_cast<std::string*>(reinterpret_cast<char*>(&Obj) + Leaf.Offset);
+    }
+
+    std::unordered_map<const ClassInfo*, std::vector<FQuantizedLeaf>> Layouts;
+};
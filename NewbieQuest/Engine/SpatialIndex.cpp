@@ -0,0 +1,280 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <string>
+#include <thread>
+#include "Object.h"
+
+namespace
+{
+    // cell coordinates are packed into 21 bits each
+    constexpr int32_t CellLimit = (1 << 20) - 1;
+
+    float DistanceSquared(const FVector& a, const FVector& b)
+    {
+        const float dx = a.X - b.X, dy = a.Y - b.Y, dz = a.Z - b.Z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // below this a rebuild isn't worth spawning threads for
+    constexpr std::size_t ParallelBuildThreshold = 4096;
+}
+
+QSpatialHashGrid::QSpatialHashGrid(const ClassInfo& Info, std::string_view PositionPath, float InCellSize)
+    : Class(&Info), CellSize(InCellSize > 0.f ? InCellSize : 1.f), InvCellSize(1.f / CellSize)
+{
+    const std::string Path(PositionPath);
+    PositionX = PropertyHandle::Resolve(Info, Path + ".X");
+    PositionY = PropertyHandle::Resolve(Info, Path + ".Y");
+    PositionZ = PropertyHandle::Resolve(Info, Path + ".Z");
+    if (PositionX.GetKind() != BasicKind::Float || PositionY.GetKind() != BasicKind::Float || PositionZ.GetKind() != BasicKind::Float)
+        PositionX = PositionY = PositionZ = PropertyHandle();
+}
+
+FVector QSpatialHashGrid::ReadPosition(const QObject& Obj) const
+{
+    FVector Position;
+    Position.X = PositionX.Get<float>(Obj);
+    Position.Y = PositionY.Get<float>(Obj);
+    Position.Z = PositionZ.Get<float>(Obj);
+    return Position;
+}
+
+int32_t QSpatialHashGrid::ToCell(float Coord) const
+{
+    const float Cell = std::floor(Coord * InvCellSize);
+    if (!(Cell > -CellLimit)) return -CellLimit; // also catches NaN
+    if (Cell > CellLimit) return CellLimit;
+    return static_cast<int32_t>(Cell);
+}
+
+uint64_t QSpatialHashGrid::MakeKey(int32_t X, int32_t Y, int32_t Z)
+{
+    constexpr uint64_t Mask = (uint64_t(1) << 21) - 1;
+    return (static_cast<uint64_t>(X) & Mask) | ((static_cast<uint64_t>(Y) & Mask) << 21) | ((static_cast<uint64_t>(Z) & Mask) << 42);
+}
+
+uint64_t QSpatialHashGrid::KeyOf(const FVector& Position) const
+{
+    return MakeKey(ToCell(Position.X), ToCell(Position.Y), ToCell(Position.Z));
+}
+
+const std::vector<QSpatialHashGrid::FEntry>* QSpatialHashGrid::FindCell(int32_t X, int32_t Y, int32_t Z) const
+{
+    const uint64_t Key = MakeKey(X, Y, Z);
+    const auto& Cells = Shards[CellShard(Key)].Cells;
+    auto It = Cells.find(Key);
+    return It == Cells.end() ? nullptr : &It->second;
+}
+
+void QSpatialHashGrid::Clear()
+{
+    for (FShard& Shard : Shards) { Shard.Cells.clear(); Shard.Locations.clear(); }
+    NumEntries = 0;
+}
+
+void QSpatialHashGrid::Build(std::span<QObject* const> Objects, unsigned NumThreads)
+{
+    Clear();
+    if (!IsValid()) return;
+
+    if (NumThreads == 0) NumThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (Objects.size() < ParallelBuildThreshold) NumThreads = 1;
+    NumThreads = std::min<unsigned>(NumThreads, NumShards);
+
+    // pass 1: positions and keys, split by object range
+    struct FItem { QObject* Object; FVector Position; uint64_t Key; };
+    std::vector<FItem> Items(Objects.size());
+    auto Gather = [&](std::size_t Begin, std::size_t End){
+        for (std::size_t i = Begin; i < End; ++i) {
+            QObject* Obj = Objects[i];
+            if (!Obj || !Obj->GetClassInfo().IsChildOf(*Class)) { Items[i].Object = nullptr; continue; }
+            const FVector Position = ReadPosition(*Obj);
+            Items[i] = { Obj, Position, KeyOf(Position) };
+        }
+    };
+
+    // pass 2: each thread owns a set of shards and inserts only into those
+    auto Fill = [&](unsigned ThreadIndex){
+        for (const FItem& Item : Items) {
+            if (!Item.Object) continue;
+            const std::size_t CellShardIndex = CellShard(Item.Key);
+            if (CellShardIndex % NumThreads == ThreadIndex)
+                Shards[CellShardIndex].Cells[Item.Key].push_back({ Item.Object, Item.Position });
+            const std::size_t ObjectShardIndex = ObjectShard(Item.Object);
+            if (ObjectShardIndex % NumThreads == ThreadIndex)
+                Shards[ObjectShardIndex].Locations[Item.Object] = Item.Key;
+        }
+    };
+
+    if (NumThreads == 1) {
+        Gather(0, Items.size());
+        Fill(0);
+    } else {
+        std::vector<std::thread> Threads;
+        const std::size_t Chunk = (Items.size() + NumThreads - 1) / NumThreads;
+        for (unsigned t = 0; t < NumThreads; ++t) {
+            const std::size_t Begin = std::min(Items.size(), t * Chunk);
+            Threads.emplace_back(Gather, Begin, std::min(Items.size(), Begin + Chunk));
+        }
+        for (auto& Thread : Threads) Thread.join();
+        Threads.clear();
+        for (unsigned t = 0; t < NumThreads; ++t) Threads.emplace_back(Fill, t);
+        for (auto& Thread : Threads) Thread.join();
+    }
+
+    for (const FShard& Shard : Shards) NumEntries += Shard.Locations.size();
+}
+
+void QSpatialHashGrid::Add(QObject* Obj)
+{
+    Update(Obj);
+}
+
+bool QSpatialHashGrid::Remove(QObject* Obj)
+{
+    auto& Locations = Shards[ObjectShard(Obj)].Locations;
+    auto It = Locations.find(Obj);
+    if (It == Locations.end()) return false;
+
+    auto& Cells = Shards[CellShard(It->second)].Cells;
+    auto CellIt = Cells.find(It->second);
+    if (CellIt != Cells.end()) {
+        auto& Entries = CellIt->second;
+        auto EntryIt = std::ranges::find(Entries, Obj, &FEntry::Object);
+        if (EntryIt != Entries.end()) { *EntryIt = Entries.back(); Entries.pop_back(); }
+        if (Entries.empty()) Cells.erase(CellIt);
+    }
+    Locations.erase(It);
+    --NumEntries;
+    return true;
+}
+
+void QSpatialHashGrid::Update(QObject* Obj)
+{
+    if (!Obj || !IsValid() || !Obj->GetClassInfo().IsChildOf(*Class)) return;
+
+    const FVector Position = ReadPosition(*Obj);
+    const uint64_t Key = KeyOf(Position);
+
+    auto& Locations = Shards[ObjectShard(Obj)].Locations;
+    auto It = Locations.find(Obj);
+    if (It != Locations.end() && It->second == Key) {
+        // same cell: only refresh the cached position
+        auto& Entries = Shards[CellShard(Key)].Cells[Key];
+        auto EntryIt = std::ranges::find(Entries, Obj, &FEntry::Object);
+        if (EntryIt != Entries.end()) { EntryIt->Position = Position; return; }
+    }
+    if (It != Locations.end()) Remove(Obj);
+
+    Shards[CellShard(Key)].Cells[Key].push_back({ Obj, Position });
+    Shards[ObjectShard(Obj)].Locations[Obj] = Key;
+    ++NumEntries;
+}
+
+template <typename Fn>
+void QSpatialHashGrid::ForEachInBox(const FVector& Min, const FVector& Max, const Fn& Func) const
+{
+    const int32_t MinX = ToCell(Min.X), MinY = ToCell(Min.Y), MinZ = ToCell(Min.Z);
+    const int32_t MaxX = ToCell(Max.X), MaxY = ToCell(Max.Y), MaxZ = ToCell(Max.Z);
+    const uint64_t NumCells = uint64_t(MaxX - MinX + 1) * uint64_t(MaxY - MinY + 1) * uint64_t(MaxZ - MinZ + 1);
+
+    std::size_t NumOccupied = 0;
+    for (const FShard& Shard : Shards) NumOccupied += Shard.Cells.size();
+
+    if (NumCells > NumOccupied) {
+        // the box spans more cells than exist: walk the occupied ones instead
+        for (const FShard& Shard : Shards)
+            for (const auto& [Key, Entries] : Shard.Cells)
+                for (const FEntry& Entry : Entries) Func(Entry);
+        return;
+    }
+
+    for (int32_t z = MinZ; z <= MaxZ; ++z)
+        for (int32_t y = MinY; y <= MaxY; ++y)
+            for (int32_t x = MinX; x <= MaxX; ++x)
+                if (const auto* Entries = FindCell(x, y, z))
+                    for (const FEntry& Entry : *Entries) Func(Entry);
+}
+
+void QSpatialHashGrid::QueryRadius(const FVector& Center, float Radius, std::vector<QObject*>& Out) const
+{
+    const FVector Min{ Center.X - Radius, Center.Y - Radius, Center.Z - Radius };
+    const FVector Max{ Center.X + Radius, Center.Y + Radius, Center.Z + Radius };
+    const float RadiusSquared = Radius * Radius;
+    ForEachInBox(Min, Max, [&](const FEntry& Entry){
+        if (DistanceSquared(Entry.Position, Center) <= RadiusSquared) Out.push_back(Entry.Object);
+    });
+}
+
+void QSpatialHashGrid::QueryBox(const FVector& Min, const FVector& Max, std::vector<QObject*>& Out) const
+{
+    ForEachInBox(Min, Max, [&](const FEntry& Entry){
+        const FVector& p = Entry.Position;
+        if (p.X >= Min.X && p.X <= Max.X && p.Y >= Min.Y && p.Y <= Max.Y && p.Z >= Min.Z && p.Z <= Max.Z)
+            Out.push_back(Entry.Object);
+    });
+}
+
+void QSpatialHashGrid::QueryNearest(const FVector& Point, std::size_t K, std::vector<QObject*>& Out) const
+{
+    if (K == 0 || NumEntries == 0) return;
+
+    // max-heap of the best K so far
+    using FCandidate = std::pair<float, QObject*>;
+    std::priority_queue<FCandidate> Best;
+
+    const int32_t CX = ToCell(Point.X), CY = ToCell(Point.Y), CZ = ToCell(Point.Z);
+    std::size_t Visited = 0;
+
+    auto VisitCell = [&](int32_t x, int32_t y, int32_t z){
+        const auto* Entries = FindCell(x, y, z);
+        if (!Entries) return;
+        for (const FEntry& Entry : *Entries) {
+            ++Visited;
+            const float d = DistanceSquared(Entry.Position, Point);
+            if (Best.size() < K) Best.push({ d, Entry.Object });
+            else if (d < Best.top().first) { Best.pop(); Best.push({ d, Entry.Object }); }
+        }
+    };
+
+    std::size_t NumOccupied = 0;
+    for (const FShard& Shard : Shards) NumOccupied += Shard.Cells.size();
+
+    // expand shells of cells around the query cell; everything outside shell r is at least r cells away
+    for (int32_t r = 0; r <= CellLimit; ++r) {
+        const uint64_t ShellCells = r == 0 ? 1 : uint64_t(24) * r * r + 2;
+        if (ShellCells > NumOccupied) {
+            // sparse grid: cheaper to scan every occupied cell than to probe empty ones
+            Best = {};
+            for (const FShard& Shard : Shards)
+                for (const auto& [Key, Entries] : Shard.Cells)
+                    for (const FEntry& Entry : Entries) {
+                        const float d = DistanceSquared(Entry.Position, Point);
+                        if (Best.size() < K) Best.push({ d, Entry.Object });
+                        else if (d < Best.top().first) { Best.pop(); Best.push({ d, Entry.Object }); }
+                    }
+            break;
+        }
+
+        for (int32_t z = CZ - r; z <= CZ + r; ++z) {
+            for (int32_t y = CY - r; y <= CY + r; ++y) {
+                if (std::abs(z - CZ) == r || std::abs(y - CY) == r) {
+                    for (int32_t x = CX - r; x <= CX + r; ++x) VisitCell(x, y, z);
+                } else {
+                    VisitCell(CX - r, y, z);
+                    if (r > 0) VisitCell(CX + r, y, z);
+                }
+            }
+        }
+
+        if (Visited == NumEntries) break;
+        const float Reach = r * CellSize;
+        if (Best.size() == K && Best.top().first <= Reach * Reach) break;
+    }
+
+    const std::size_t Start = Out.size();
+    Out.resize(Start + Best.size());
+    for (std::size_t i = Out.size(); i-- > Start; ) { Out[i] = Best.top().second; Best.pop(); }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "CoreMinimal.h"
+#include "Vector.h"
+
+class QObject;
+
+// Uniform hash grid over an FVector leaf of a reflected class, chosen by property path
+// (e.g. "Position" on QMonster). Cells are spread over independent shards so a full
+// rebuild can fill them from several threads without locking.
+class QSpatialHashGrid
+{
+public:
+    QSpatialHashGrid(const ClassInfo& Info, std::string_view PositionPath, float InCellSize);
+
+    // false if PositionPath doesn't name an FVector of the class
+    bool IsValid() const { return PositionX.IsValid() && PositionY.IsValid() && PositionZ.IsValid(); }
+
+    // Replace the contents with Objects. NumThreads = 0 picks the hardware concurrency.
+    // Objects of other classes are skipped.
+    void Build(std::span<QObject* const> Objects, unsigned NumThreads = 0);
+
+    void Add(QObject* Obj);
+    bool Remove(QObject* Obj);
+    // re-read the position of Obj after it moved; adds it if unknown
+    void Update(QObject* Obj);
+    void Clear();
+
+    std::size_t Size() const { return NumEntries; }
+
+    // results are appended to Out
+    void QueryRadius(const FVector& Center, float Radius, std::vector<QObject*>& Out) const;
+    void QueryBox(const FVector& Min, const FVector& Max, std::vector<QObject*>& Out) const;
+    // the K closest objects, nearest first
+    void QueryNearest(const FVector& Point, std::size_t K, std::vector<QObject*>& Out) const;
+
+private:
+    struct FEntry
+    {
+        QObject* Object;
+        FVector  Position;
+    };
+
+    struct FKeyHash
+    {
+        std::size_t operator()(uint64_t Key) const
+        {
+            // splitmix64 finalizer, packed cell coordinates are poorly distributed on their own
+            Key ^= Key >> 30; Key *= 0xbf58476d1ce4e5b9ull;
+            Key ^= Key >> 27; Key *= 0x94d049bb133111ebull;
+            Key ^= Key >> 31;
+            return static_cast<std::size_t>(Key);
+        }
+    };
+
+    static constexpr std::size_t NumShards = 16;
+
+    struct FShard
+    {
+        std::unordered_map<uint64_t, std::vector<FEntry>, FKeyHash> Cells;
+        std::unordered_map<QObject*, uint64_t> Locations; // objects whose pointer hashes to this shard
+    };
+
+    FVector ReadPosition(const QObject& Obj) const;
+    int32_t ToCell(float Coord) const;
+    static uint64_t MakeKey(int32_t X, int32_t Y, int32_t Z);
+    uint64_t KeyOf(const FVector& Position) const;
+
+    static std::size_t CellShard(uint64_t Key) { return FKeyHash{}(Key) % NumShards; }
+    static std::size_t ObjectShard(const QObject* Obj) { return FKeyHash{}(reinterpret_cast<uintptr_t>(Obj)) % NumShards; }
+
+    const std::vector<FEntry>* FindCell(int32_t X, int32_t Y, int32_t Z) const;
+
+    // visit every entry in the cells overlapping [Min, Max]
+    template <typename Fn>
+    void ForEachInBox(const FVector& Min, const FVector& Max, const Fn& Func) const;
+
+    const ClassInfo* Class;
+    PropertyHandle   PositionX, PositionY, PositionZ;
+    float            CellSize;
+    float            InvCellSize;
+
+    std::array<FShard, NumShards> Shards;
+    std::size_t NumEntries = 0;
+};
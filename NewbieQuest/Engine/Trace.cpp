@@ -0,0 +1,190 @@
+#include "Trace.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct FTraceEvent
+    {
+        const char* Name = nullptr;
+        uint64_t    StartNs = 0;
+        uint64_t    EndNs = 0;
+        uint32_t    ThreadId = 0;
+        char        Asset[96] = {};
+        char        Class[48] = {};
+    };
+
+    // Single-producer ring. Each slot carries a sequence number (odd while being written)
+    // so a concurrent dump can skip slots that are torn or already overwritten.
+    struct FTraceRing
+    {
+        static constexpr std::size_t Capacity = 1 << 14;
+
+        struct FSlot
+        {
+            std::atomic<uint64_t> Seq{0};
+            FTraceEvent           Event;
+        };
+
+        std::array<FSlot, Capacity> Slots;
+        std::atomic<uint64_t>       Head{0};
+        std::atomic<uint64_t>       Tail{0}; // first index still visible after Clear()
+    };
+
+    // Rings outlive their threads so the events stay dumpable, and a ring whose thread
+    // exited is handed to the next new thread, so there are never more rings than
+    // threads that were alive at the same time (short-lived worker pools reuse them).
+    struct FTraceRings
+    {
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<FTraceRing>> Rings;
+        std::vector<FTraceRing*> FreeRings;
+        uint32_t NextThreadId = 1;
+
+        static FTraceRings& Get() { static FTraceRings R; return R; }
+    };
+
+    // the calling thread's ring, returned to the free list when the thread exits
+    struct FRingLease
+    {
+        FTraceRing* Ring = nullptr;
+        uint32_t    ThreadId = 0;
+
+        FRingLease()
+        {
+            FTraceRings& Rings = FTraceRings::Get();
+            std::lock_guard Lock(Rings.Mutex);
+            ThreadId = Rings.NextThreadId++;
+            if (!Rings.FreeRings.empty()) {
+                Ring = Rings.FreeRings.back();
+                Rings.FreeRings.pop_back();
+            } else {
+                Ring = Rings.Rings.emplace_back(std::make_unique<FTraceRing>()).get();
+            }
+        }
+        ~FRingLease()
+        {
+            FTraceRings& Rings = FTraceRings::Get();
+            std::lock_guard Lock(Rings.Mutex);
+            Rings.FreeRings.push_back(Ring);
+        }
+    };
+
+    FRingLease& ThisThreadLease()
+    {
+        thread_local FRingLease Lease;
+        return Lease;
+    }
+
+    // keep the tail of long strings, that's where asset paths differ
+    template <std::size_t N>
+    void CopyTail(char (&Dst)[N], std::string_view Src)
+    {
+        if (Src.size() >= N) Src = Src.substr(Src.size() - (N - 1));
+        if (!Src.empty()) std::memcpy(Dst, Src.data(), Src.size());
+        Dst[Src.size()] = '\0';
+    }
+
+    void WriteJsonString(std::ofstream& OutputStream, const char* s)
+    {
+        OutputStream << '"';
+        for (; *s; ++s) {
+            const unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') OutputStream << '\\' << *s;
+            else if (c < 0x20) { char Buf[8]; std::snprintf(Buf, sizeof(Buf), "\\u%04x", c); OutputStream << Buf; }
+            else OutputStream << *s;
+        }
+        OutputStream << '"';
+    }
+}
+
+uint64_t QTrace::NowNs()
+{
+    static const auto Epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count());
+}
+
+void QTrace::Record(const char* Name, uint64_t StartNs, uint64_t EndNs, std::string_view Asset, std::string_view Class)
+{
+    const FRingLease& Lease = ThisThreadLease();
+    FTraceRing& Ring = *Lease.Ring;
+    const uint64_t Index = Ring.Head.load(std::memory_order_relaxed);
+    FTraceRing::FSlot& Slot = Ring.Slots[Index & (FTraceRing::Capacity - 1)];
+
+    Slot.Seq.store(Index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot.Event.Name = Name;
+    Slot.Event.StartNs = StartNs;
+    Slot.Event.EndNs = EndNs;
+    Slot.Event.ThreadId = Lease.ThreadId;
+    CopyTail(Slot.Event.Asset, Asset);
+    CopyTail(Slot.Event.Class, Class);
+    Slot.Seq.store(Index * 2 + 2, std::memory_order_release);
+
+    Ring.Head.store(Index + 1, std::memory_order_release);
+}
+
+void QTrace::Clear()
+{
+    FTraceRings& Rings = FTraceRings::Get();
+    std::lock_guard Lock(Rings.Mutex);
+    for (auto& Ring : Rings.Rings) Ring->Tail.store(Ring->Head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+bool QTrace::DumpToFile(const std::filesystem::path& Path)
+{
+    // rings are never freed, only handed to other threads, so the pointers stay valid
+    std::vector<const FTraceRing*> Rings;
+    {
+        FTraceRings& Registry = FTraceRings::Get();
+        std::lock_guard Lock(Registry.Mutex);
+        for (const auto& Ring : Registry.Rings) Rings.push_back(Ring.get());
+    }
+
+    std::ofstream OutputStream(Path, std::ios::out | std::ios::trunc);
+    if (!OutputStream) return false;
+
+    OutputStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool bFirst = true;
+    char Number[64];
+
+    for (const auto& Ring : Rings) {
+        const uint64_t Head = Ring->Head.load(std::memory_order_acquire);
+        const uint64_t Oldest = Head > FTraceRing::Capacity ? Head - FTraceRing::Capacity : 0;
+        const uint64_t Begin = std::max(Oldest, Ring->Tail.load(std::memory_order_relaxed));
+
+        for (uint64_t Index = Begin; Index < Head; ++Index) {
+            const FTraceRing::FSlot& Slot = Ring->Slots[Index & (FTraceRing::Capacity - 1)];
+            const uint64_t SeqBefore = Slot.Seq.load(std::memory_order_acquire);
+            if (SeqBefore != Index * 2 + 2) continue;
+            const FTraceEvent Event = Slot.Event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (Slot.Seq.load(std::memory_order_relaxed) != SeqBefore) continue; // overwritten meanwhile
+
+            if (!bFirst) OutputStream << ",\n";
+            bFirst = false;
+
+            OutputStream << "{\"name\":";
+            WriteJsonString(OutputStream, Event.Name);
+            std::snprintf(Number, sizeof(Number), "%.3f", Event.StartNs / 1000.0);
+            OutputStream << ",\"cat\":\"asset\",\"ph\":\"X\",\"ts\":" << Number;
+            std::snprintf(Number, sizeof(Number), "%.3f", (Event.EndNs - Event.StartNs) / 1000.0);
+            OutputStream << ",\"dur\":" << Number << ",\"pid\":1,\"tid\":" << Event.ThreadId;
+            OutputStream << ",\"args\":{\"asset\":";
+            WriteJsonString(OutputStream, Event.Asset);
+            OutputStream << ",\"class\":";
+            WriteJsonString(OutputStream, Event.Class);
+            OutputStream << "}}";
+        }
+    }
+    OutputStream << "\n]}\n";
+    return bool(OutputStream);
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// Chrome / Perfetto trace-event capture ("Complete" X events, open with chrome://tracing or ui.perfetto.dev).
+// Each thread records into its own fixed-size ring buffer without locks; the oldest events are
+// overwritten when a ring is full. A thread that exits leaves its ring (and its events) to the
+// next new thread. Disabled by default, a disabled zone costs one relaxed load.
+class QTrace
+{
+public:
+    static void SetEnabled(bool bEnable) { bEnabled.store(bEnable, std::memory_order_relaxed); }
+    static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+    // write every buffered event of every thread as trace-event JSON
+    static bool DumpToFile(const std::filesystem::path& Path);
+
+    // drop buffered events (threads keep their rings)
+    static void Clear();
+
+    static uint64_t NowNs();
+    static void Record(const char* Name, uint64_t StartNs, uint64_t EndNs, std::string_view Asset, std::string_view Class);
+
+private:
+    static inline std::atomic<bool> bEnabled{false};
+};
+
+// Scoped zone tagged with the asset and, once known, the ClassInfo name.
+class QTraceZone
+{
+public:
+    QTraceZone(const char* InName, std::string_view InAsset, std::string_view InClass = {})
+    {
+        if (!QTrace::IsEnabled()) return;
+        Name = InName; Asset = InAsset; Class = InClass;
+        StartNs = QTrace::NowNs();
+    }
+    ~QTraceZone()
+    {
+        if (Name) QTrace::Record(Name, StartNs, QTrace::NowNs(), Asset, Class);
+    }
+
+    QTraceZone(const QTraceZone&) = delete;
+    QTraceZone& operator=(const QTraceZone&) = delete;
+
+    // the referenced strings must outlive the zone
+    void SetAssetName(std::string_view InAsset) { Asset = InAsset; }
+    void SetClassName(std::string_view InClass) { Class = InClass; }
+
+private:
+    const char*      Name = nullptr; // null when tracing was off at construction
+    std::string_view Asset;
+    std::string_view Class;
+    uint64_t         StartNs = 0;
+};
+
+#define QTRACE_CONCAT_INNER(a, b) a##b
+#define QTRACE_CONCAT(a, b) QTRACE_CONCAT_INNER(a, b)
+
+// QTRACE_ZONE("Read", AssetName) or QTRACE_ZONE("Read", AssetName, Info.Name)
+// The zone keeps string_views, so bind temporaries (path.string(), ...) to a local first.
+#define QTRACE_ZONE(Name, ...) QTraceZone QTRACE_CONCAT(TraceZone_, __LINE__)(Name, __VA_ARGS__)
@@ -5,4 +5,18 @@
 int main() {
     
     Demo::Case1();
+    Demo::SnapshotBenchmark();
+    Demo::BufferRoundTrip();
+    Demo::DuplicateBenchmark();
+    Demo::AssignByPath();
+    Demo::TraceAssetOperations();
+    Demo::StreamAssets();
+    Demo::SpatialQueries();
+    Demo::RoundTripValueTypes();
+    Demo::QueryMonsters();
+    Demo::SaveAndLoadWorld();
+    Demo::CookTextAssets();
+    Demo::MountedLoads();
+    Demo::ShareAssetsAcrossProcesses();
+    Demo::ChangeNotifications();
 }
@@ -0,0 +1,174 @@
+#include "Reflection/Public/ChangeNotify.h"
+#include <algorithm>
+#include "Object.h"
+#include "Reflection/Public/PropertyHandle.h"
+
+void QChangeNotifier::Record(QObject& Obj, std::size_t Offset, std::size_t Size)
+{
+    FChangeBuffer& Buffer = LocalBuffer();
+    std::lock_guard Lock(Buffer.Mutex);
+    // the last subscriber may have left since the caller checked; DiscardRecords runs after the flag drops
+    if (!IsEnabled()) return;
+    Buffer.Records.push_back({ &Obj, &Obj.GetClassInfo(), static_cast<uint32_t>(Offset), static_cast<uint32_t>(Size) });
+}
+
+QChangeNotifier::FChangeBuffer& QChangeNotifier::LocalBuffer()
+{
+    thread_local std::shared_ptr<FChangeBuffer> Local;
+    if (!Local) {
+        Local = std::make_shared<FChangeBuffer>();
+        std::lock_guard Lock(BuffersMutex);
+        Buffers.push_back(Local);
+    }
+    return *Local;
+}
+
+void QChangeNotifier::DiscardRecords()
+{
+    std::lock_guard Lock(BuffersMutex);
+    for (const std::shared_ptr<FChangeBuffer>& Buffer : Buffers) {
+        std::lock_guard BufferLock(Buffer->Mutex);
+        Buffer->Records = {};
+    }
+    std::erase_if(Buffers, [](const std::shared_ptr<FChangeBuffer>& Buffer){ return Buffer.use_count() == 1; });
+}
+
+const QChangeNotifier::FOffsetTable& QChangeNotifier::GetOffsetTable(const ClassInfo& Info)
+{
+    auto [It, bInserted] = OffsetTables.try_emplace(&Info);
+    if (bInserted) {
+        const std::vector<LeafInfo>& Leaves = Info.GetLeaves();
+        for (std::size_t i = 0; i < Leaves.size(); ++i) It->second.emplace_back(Leaves[i].Offset, static_cast<uint32_t>(i));
+        std::ranges::sort(It->second);
+    }
+    return It->second;
+}
+
+uint64_t QChangeNotifier::AddSubscriber(std::shared_ptr<FSubscriber> Subscriber)
+{
+    std::lock_guard Lock(SubscribersMutex);
+    Subscriber->Id = NextId++;
+    Subscribers.push_back(std::move(Subscriber));
+    bEnabled.store(true, std::memory_order_relaxed);
+    return Subscribers.back()->Id;
+}
+
+uint64_t QChangeNotifier::Subscribe(const ClassInfo& Info, FClassCallback Callback)
+{
+    auto Subscriber = std::make_shared<FSubscriber>();
+    Subscriber->Class = &Info;
+    Subscriber->OnClass = std::move(Callback);
+    return AddSubscriber(std::move(Subscriber));
+}
+
+uint64_t QChangeNotifier::Subscribe(const PropertyHandle& Handle, FPropertyCallback Callback)
+{
+    if (!Handle.IsValid()) return 0;
+    auto Subscriber = std::make_shared<FSubscriber>();
+    Subscriber->Class = Handle.GetClass();
+    Subscriber->Offset = Handle.GetOffset();
+    Subscriber->OnProperty = std::move(Callback);
+    return AddSubscriber(std::move(Subscriber));
+}
+
+uint64_t QChangeNotifier::Subscribe(const ClassInfo& Info, std::string_view LeafPath, FPropertyCallback Callback)
+{
+    return Subscribe(PropertyHandle::Resolve(Info, LeafPath), std::move(Callback));
+}
+
+void QChangeNotifier::Unsubscribe(uint64_t Id)
+{
+    std::lock_guard Lock(SubscribersMutex);
+    std::erase_if(Subscribers, [Id](const auto& Subscriber){ return Subscriber->Id == Id; });
+    bEnabled.store(!Subscribers.empty(), std::memory_order_relaxed);
+    // nobody is left to flush them, and their object pointers may go stale;
+    // still under the lock so a new subscriber's first records survive
+    if (Subscribers.empty()) DiscardRecords();
+}
+
+std::size_t QChangeNotifier::Flush()
+{
+    std::lock_guard FlushLock(FlushMutex);
+
+    std::vector<FChangeRecord> Pending;
+    {
+        std::lock_guard Lock(BuffersMutex);
+        for (const std::shared_ptr<FChangeBuffer>& Buffer : Buffers) {
+            std::lock_guard BufferLock(Buffer->Mutex);
+            Pending.insert(Pending.end(), Buffer->Records.begin(), Buffer->Records.end());
+            Buffer->Records.clear();
+        }
+        // threads that exited left only our reference behind, and it's drained now
+        std::erase_if(Buffers, [](const std::shared_ptr<FChangeBuffer>& Buffer){ return Buffer.use_count() == 1; });
+    }
+    if (Pending.empty()) return 0;
+
+    // byte ranges -> (class, leaf, object), sorted so duplicates sit next to each other
+    struct FEntry
+    {
+        const ClassInfo* Class;
+        uint32_t         LeafIndex;
+        QObject*         Object;
+    };
+    std::vector<FEntry> Entries;
+    Entries.reserve(Pending.size());
+    for (const FChangeRecord& Change : Pending) {
+        const FOffsetTable& Table = GetOffsetTable(*Change.Class);
+        auto It = std::ranges::lower_bound(Table, std::pair<std::size_t, uint32_t>(Change.Offset, 0));
+        for (; It != Table.end() && It->first < std::size_t(Change.Offset) + Change.Size; ++It)
+            Entries.push_back({ Change.Class, It->second, Change.Object });
+    }
+    std::ranges::sort(Entries, [](const FEntry& a, const FEntry& b){
+        if (a.Class != b.Class) return std::less<const ClassInfo*>{}(a.Class, b.Class);
+        if (a.LeafIndex != b.LeafIndex) return a.LeafIndex < b.LeafIndex;
+        return std::less<QObject*>{}(a.Object, b.Object);
+    });
+    Entries.erase(std::unique(Entries.begin(), Entries.end(), [](const FEntry& a, const FEntry& b){
+        return a.Class == b.Class && a.LeafIndex == b.LeafIndex && a.Object == b.Object;
+    }), Entries.end());
+
+    // flatten into one object column with per-leaf and per-class ranges over it
+    struct FGroup
+    {
+        const ClassInfo* Class;
+        std::size_t      FirstLeaf;
+        std::size_t      NumLeaves;
+    };
+    std::vector<QObject*> Objects(Entries.size());
+    std::vector<FLeafChanges> Leaves;
+    std::vector<FGroup> Groups;
+    std::size_t LeafBegin = 0;
+    for (std::size_t i = 0; i < Entries.size(); ++i) {
+        Objects[i] = Entries[i].Object;
+        const bool bLastOfLeaf = i + 1 == Entries.size() || Entries[i + 1].Class != Entries[i].Class
+                              || Entries[i + 1].LeafIndex != Entries[i].LeafIndex;
+        if (!bLastOfLeaf) continue;
+        if (Groups.empty() || Groups.back().Class != Entries[i].Class) Groups.push_back({ Entries[i].Class, Leaves.size(), 0 });
+        Leaves.push_back({ Entries[i].LeafIndex, std::span<QObject* const>(Objects.data() + LeafBegin, i + 1 - LeafBegin) });
+        ++Groups.back().NumLeaves;
+        LeafBegin = i + 1;
+    }
+
+    // subscribers may (un)subscribe from their callbacks
+    std::vector<std::shared_ptr<const FSubscriber>> Targets;
+    {
+        std::lock_guard Lock(SubscribersMutex);
+        Targets = Subscribers;
+    }
+
+    for (const FGroup& Group : Groups) {
+        const FClassChanges Changes{ Group.Class, std::span<const FLeafChanges>(Leaves.data() + Group.FirstLeaf, Group.NumLeaves) };
+        for (const std::shared_ptr<const FSubscriber>& Subscriber : Targets) {
+            if (!Group.Class->IsChildOf(*Subscriber->Class)) continue;
+            if (Subscriber->OnClass) { Subscriber->OnClass(Changes); continue; }
+
+            // the subscribed leaf sits at the same offset in every subclass
+            const FOffsetTable& Table = GetOffsetTable(*Group.Class);
+            auto It = std::ranges::lower_bound(Table, std::pair<std::size_t, uint32_t>(Subscriber->Offset, 0));
+            if (It == Table.end() || It->first != Subscriber->Offset) continue;
+            auto Leaf = std::ranges::lower_bound(Changes.Leaves, It->second, {}, &FLeafChanges::LeafIndex);
+            if (Leaf != Changes.Leaves.end() && Leaf->LeafIndex == It->second) Subscriber->OnProperty(*Group.Class, Leaf->Objects);
+        }
+    }
+    return Entries.size();
+}
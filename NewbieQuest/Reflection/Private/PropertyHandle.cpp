@@ -0,0 +1,62 @@
+#include "Reflection/Public/PropertyHandle.h"
+#include "Object.h"
+
+PropertyHandle PropertyHandle::Resolve(const ClassInfo& Info, std::string_view Path)
+{
+    PropertyHandle Handle;
+    const std::vector<LeafInfo>& Leaves = Info.GetLeaves();
+    for (std::size_t i = 0; i < Leaves.size(); ++i) {
+        if (Leaves[i].Path != Path) continue;
+        Handle.Class = &Info;
+        Handle.Kind = Leaves[i].Kind;
+        Handle.ValueKind = Leaves[i].ValueKind;
+        Handle.Offset = Leaves[i].Offset;
+        Handle.LeafIndex = i;
+        break;
+    }
+    return Handle;
+}
+
+std::size_t ApplyAssignments(std::span<QObject* const> Objects, std::span<const PropertyAssignment> Assignments)
+{
+    std::size_t Writes = 0;
+    const ClassInfo* LastClass = nullptr;
+    std::vector<char> Applies(Assignments.size());
+
+    for (QObject* Obj : Objects) {
+        // which assignments fit this object; recomputed only when the class changes
+        const ClassInfo* Info = &Obj->GetClassInfo();
+        if (Info != LastClass) {
+            LastClass = Info;
+            for (std::size_t a = 0; a < Assignments.size(); ++a) {
+                const PropertyAssignment& Assign = Assignments[a];
+                Applies[a] = Assign.Handle.IsValid() && Assign.Handle.GetKind() == Assign.Value.Kind
+                          && Info->IsChildOf(*Assign.Handle.GetClass());
+            }
+        }
+
+        for (std::size_t a = 0; a < Assignments.size(); ++a) {
+            if (!Applies[a]) continue;
+            const PropertyAssignment& Assign = Assignments[a];
+            switch (Assign.Value.Kind) {
+            case BasicKind::Bool:   Assign.Handle.Set(*Obj, Assign.Value.b); break;
+            case BasicKind::Float:  Assign.Handle.Set(*Obj, Assign.Value.f); break;
+            case BasicKind::Double: Assign.Handle.Set(*Obj, Assign.Value.d); break;
+            case BasicKind::String: Assign.Handle.Set(*Obj, Assign.Value.s); break;
+            case BasicKind::Struct: continue;
+            default: {
+                void* Ptr = Assign.Handle.Ptr(*Obj);
+                const BasicKind ValueKind = Assign.Handle.GetValueKind();
+                if (QChangeNotifier::IsEnabled() && LoadInteger(Ptr, ValueKind) != Assign.Value.i) {
+                    StoreInteger(Ptr, ValueKind, Assign.Value.i);
+                    QChangeNotifier::NotifyChanged(*Obj, Assign.Handle.GetOffset(), KindSize(ValueKind));
+                } else {
+                    StoreInteger(Ptr, ValueKind, Assign.Value.i);
+                }
+            } break;
+            }
+            ++Writes;
+        }
+    }
+    return Writes;
+}
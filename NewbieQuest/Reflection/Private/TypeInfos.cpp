@@ -0,0 +1,78 @@
+#include "Reflection/Public/TypeInfos.h"
+#include <algorithm>
+#include "Object.h"
+
+namespace
+{
+    void GatherStructLeaves(const char* Base, const void* StructPtr, const StructInfo& Si,
+                            const std::string& Prefix, const PropertyMeta& Inherited, std::vector<LeafInfo>& Out)
+    {
+        Si.ForEachProperty([&](const PropertyBase& Sp){
+            const PropertyMeta& Meta = Sp.Meta.bRanged ? Sp.Meta : Inherited;
+            const void* Ptr = Sp.ConstPtr(StructPtr);
+            if (Sp.Kind == BasicKind::Struct && Sp.GetStructInfo()) {
+                GatherStructLeaves(Base, Ptr, *Sp.GetStructInfo(), Prefix + Sp.Name + ".", Meta, Out);
+            } else {
+                Out.push_back({ Prefix + Sp.Name, &Sp, Sp.Kind, Sp.ValueKind,
+                                static_cast<std::size_t>(static_cast<const char*>(Ptr) - Base), Sp.ValueSize(), Meta });
+            }
+        });
+    }
+}
+
+const std::vector<LeafInfo>& ClassInfo::GetLeaves() const
+{
+    std::call_once(LeavesOnce, [this]{
+        if (!Factory) return;
+
+        // members are laid out identically in every instance, so one sample is enough
+        const std::unique_ptr<QObject> Sample = Factory();
+        const char* Base = reinterpret_cast<const char*>(Sample.get());
+
+        ForEachProperty([&](const PropertyBase& p){
+            const void* Ptr = p.ConstPtr(Sample.get());
+            if (p.Kind == BasicKind::Struct && p.GetStructInfo()) {
+                GatherStructLeaves(Base, Ptr, *p.GetStructInfo(), p.Name + ".", p.Meta, Leaves);
+            } else {
+                Leaves.push_back({ p.Name, &p, p.Kind, p.ValueKind,
+                                   static_cast<std::size_t>(static_cast<const char*>(Ptr) - Base), p.ValueSize(), p.Meta });
+            }
+        });
+    });
+    return Leaves;
+}
+
+const std::vector<CopyRun>& ClassInfo::GetCopyPlan() const
+{
+    std::call_once(CopyPlanOnce, [this]{
+        std::vector<CopyRun> Ranges;
+        for (const LeafInfo& Leaf : GetLeaves()) Ranges.push_back({ Leaf.Offset, Leaf.Size, Leaf.Kind == BasicKind::String });
+        std::ranges::sort(Ranges, {}, &CopyRun::Offset);
+
+        // only merge leaves that touch; a gap may hold padding or a non-reflected member
+        for (const CopyRun& Range : Ranges) {
+            if (!Range.bString && !CopyPlan.empty() && !CopyPlan.back().bString
+                && CopyPlan.back().Offset + CopyPlan.back().Size == Range.Offset) {
+                CopyPlan.back().Size += Range.Size;
+            } else {
+                CopyPlan.push_back(Range);
+            }
+        }
+    });
+    return CopyPlan;
+}
+
+uint64_t ClassInfo::GetSchemaHash() const
+{
+    std::call_once(SchemaHashOnce, [this]{
+        uint64_t Hash = Fnv1a64(Name.data(), Name.size());
+        for (const LeafInfo& Leaf : GetLeaves()) {
+            // the separators keep "ab"+"c" and "a"+"bc" apart
+            Hash = Fnv1a64(Leaf.Path.data(), Leaf.Path.size() + 1, Hash);
+            Hash = Fnv1a64(Leaf.Property->TypeName.data(), Leaf.Property->TypeName.size() + 1, Hash);
+            Hash = Fnv1a64(&Leaf.ValueKind, sizeof(Leaf.ValueKind), Hash);
+        }
+        SchemaHash = Hash;
+    });
+    return SchemaHash;
+}
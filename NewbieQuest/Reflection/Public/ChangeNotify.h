@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class QObject;
+class PropertyHandle;
+struct ClassInfo;
+
+// One leaf's changed objects, each listed once per flush, in address order.
+struct FLeafChanges
+{
+    uint32_t LeafIndex = 0;                 // into Class->GetLeaves()
+    std::span<QObject* const> Objects;
+};
+
+// Everything that changed on objects of one (most-derived) class since the last flush.
+struct FClassChanges
+{
+    const ClassInfo* Class = nullptr;
+    std::span<const FLeafChanges> Leaves;   // ascending LeafIndex
+};
+
+// Batched change notification for reflected properties.
+//
+// Writes through PropertyHandle::Set / ApplyAssignments, and setters that opt in with
+// QNOTIFY_CHANGED, append a compact (object, class, byte range) record to a buffer owned
+// by the writing thread. Flush() collects every thread's buffer, maps the byte ranges to
+// leaves, drops duplicates and hands each subscriber its share, grouped by class and leaf.
+// Nothing is recorded while there are no subscribers, and when the last one unsubscribes
+// the records still pending are dropped and the thread buffers freed.
+//
+// Records hold raw object pointers: flush before destroying objects that may have pending
+// changes. Subscribers run on the flushing thread; changes they make land in the next flush.
+class QChangeNotifier
+{
+public:
+    static QChangeNotifier& Get() { static QChangeNotifier Notifier; return Notifier; }
+
+    static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+    // Obj's bytes [Offset, Offset + Size) changed; Offset counts from the QObject address
+    static void NotifyChanged(QObject& Obj, std::size_t Offset, std::size_t Size)
+    {
+        if (IsEnabled()) Get().Record(Obj, Offset, Size);
+    }
+
+    using FClassCallback = std::function<void(const FClassChanges&)>;
+    using FPropertyCallback = std::function<void(const ClassInfo&, std::span<QObject* const>)>;
+
+    // Changes on Info and its subclasses, one call per changed class. Returns 0 for an invalid
+    // handle or path, otherwise an id for Unsubscribe.
+    uint64_t Subscribe(const ClassInfo& Info, FClassCallback Callback);
+    // objects whose leaf changed, one call per changed class
+    uint64_t Subscribe(const PropertyHandle& Handle, FPropertyCallback Callback);
+    uint64_t Subscribe(const ClassInfo& Info, std::string_view LeafPath, FPropertyCallback Callback);
+    void     Unsubscribe(uint64_t Id);
+
+    // delivers the changes recorded since the last flush; returns the number of (object, leaf) changes
+    std::size_t Flush();
+
+private:
+    struct FChangeRecord
+    {
+        QObject*         Object;
+        const ClassInfo* Class;
+        uint32_t         Offset;
+        uint32_t         Size;
+    };
+
+    // owned by one writing thread; the mutex only meets contention during a flush
+    struct FChangeBuffer
+    {
+        std::mutex Mutex;
+        std::vector<FChangeRecord> Records;
+    };
+
+    struct FSubscriber
+    {
+        uint64_t          Id = 0;
+        const ClassInfo*  Class = nullptr;
+        std::size_t       Offset = 0;       // leaf offset for property subscribers
+        FClassCallback    OnClass;
+        FPropertyCallback OnProperty;
+    };
+
+    // (offset, leaf index) sorted by offset
+    using FOffsetTable = std::vector<std::pair<std::size_t, uint32_t>>;
+
+    void Record(QObject& Obj, std::size_t Offset, std::size_t Size);
+    FChangeBuffer& LocalBuffer();
+    // drops every pending record; called with SubscribersMutex held
+    void DiscardRecords();
+    const FOffsetTable& GetOffsetTable(const ClassInfo& Info);
+    uint64_t AddSubscriber(std::shared_ptr<FSubscriber> Subscriber);
+
+    static inline std::atomic<bool> bEnabled{false};
+
+    std::mutex BuffersMutex;
+    std::vector<std::shared_ptr<FChangeBuffer>> Buffers;   // kept past their thread's exit until drained
+
+    std::mutex SubscribersMutex;
+    std::vector<std::shared_ptr<const FSubscriber>> Subscribers;
+    uint64_t NextId = 1;
+
+    std::mutex FlushMutex;                                  // one flush at a time; guards the tables below
+    std::unordered_map<const ClassInfo*, FOffsetTable> OffsetTables;
+};
+
+// In an opting-in setter, after Field was assigned:
+//   void SetLevel(int v) { if (Level == v) return; Level = v; QNOTIFY_CHANGED(Level); }
+#define QNOTIFY_CHANGED(Field) \
+    ::QChangeNotifier::NotifyChanged(*this, \
+        static_cast<std::size_t>(reinterpret_cast<const char*>(&(Field)) \
+                               - reinterpret_cast<const char*>(static_cast<const QObject*>(this))), \
+        sizeof(Field))
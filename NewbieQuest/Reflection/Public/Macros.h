@@ -32,6 +32,16 @@ private: \
 #define QFIELD(Member) \
     CI.Properties.push_back(::MakeProperty<ThisClass>(#Member, &ThisClass::Member));
 
+// ranged field, quantized to Bits over [Min, Max] in snapshots
+#define QFIELD_RANGE(Member, Min, Max, Bits) \
+    QFIELD(Member) \
+    CI.Properties.back()->Meta = ::PropertyMeta::WithBits(Min, Max, Bits);
+
+// ranged field, quantized to a resolution of Step over [Min, Max] in snapshots
+#define QFIELD_STEP(Member, Min, Max, Step) \
+    QFIELD(Member) \
+    CI.Properties.back()->Meta = ::PropertyMeta::WithStep(Min, Max, Step);
+
 #define END_REFLECTION() }
 
 // ----- Struct -----
@@ -58,4 +68,12 @@ private: \
 #define SFIELD(Member) \
     si.Properties.push_back(::MakeProperty<ThisStruct>(#Member, &ThisStruct::Member));
 
+#define SFIELD_RANGE(Member, Min, Max, Bits) \
+    SFIELD(Member) \
+    si.Properties.back()->Meta = ::PropertyMeta::WithBits(Min, Max, Bits);
+
+#define SFIELD_STEP(Member, Min, Max, Step) \
+    SFIELD(Member) \
+    si.Properties.back()->Meta = ::PropertyMeta::WithStep(Min, Max, Step);
+
 #define END_REFLECTION_STRUCT() }
@@ -1,7 +1,10 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <algorithm>
 #include <concepts>
+#include <cmath>
+#include <cstdint>
 
 #include "TypeTraits.h"
 
@@ -10,18 +13,48 @@ struct StructInfo;
 // primitive + struct
 enum class BasicKind : std::uint8_t;
 
-struct PropertyBase
+// Optional value range of a property, used for quantized (bit-packed) encoding.
+// On a struct property it applies to every numeric leaf of the struct (e.g. FVector Position).
+struct PropertyMeta
 {
-    std::string Name;
-    std::string TypeName;
-    BasicKind   Kind;
+    bool    bRanged = false;
+    double  Min = 0.0;
+    double  Max = 0.0;
+    uint8_t Bits = 0; // 0 = not quantized, use the full width of the type
+
+    // InBits is clamped to 1..63: 0 would leave no codes and 64 can't form the (1 << Bits) - 1 code range
+    static PropertyMeta WithBits(double InMin, double InMax, uint8_t InBits)
+    {
+        PropertyMeta Meta;
+        Meta.bRanged = true; Meta.Min = InMin; Meta.Max = InMax; Meta.Bits = std::clamp<uint8_t>(InBits, 1, 63);
+        return Meta;
+    }
+
+    // smallest bit count that keeps a resolution of Step over [Min, Max]
+    static PropertyMeta WithStep(double InMin, double InMax, double Step)
+    {
+        const double Steps = std::ceil((InMax - InMin) / Step);
+        uint8_t Bits = 1;
+        while (Bits < 32 && static_cast<double>((uint64_t(1) << Bits) - 1) < Steps) ++Bits;
+        return WithBits(InMin, InMax, Bits);
+    }
+};
 
-    PropertyBase(std::string InPropertyName, std::string TypeName, BasicKind k)
-        : Name(std::move(InPropertyName)), TypeName(std::move(TypeName)), Kind(k) {}
+struct PropertyBase
+{
+    std::string  Name;
+    std::string  TypeName;
+    BasicKind    Kind;
+    BasicKind    ValueKind; // how the value is stored: the underlying integer kind for enums, else Kind
+    PropertyMeta Meta;
+
+    PropertyBase(std::string InPropertyName, std::string TypeName, BasicKind k, BasicKind InValueKind)
+        : Name(std::move(InPropertyName)), TypeName(std::move(TypeName)), Kind(k), ValueKind(InValueKind) {}
     virtual ~PropertyBase() {}
 
     virtual void*       Ptr(void* Obj) const = 0;
     virtual const void* ConstPtr(const void* Obj) const = 0;
+    virtual std::size_t ValueSize() const = 0;
 
     virtual std::string GetAsString(const void* Obj) const = 0;
     virtual bool        SetFromString(void* Obj, const std::string& s) const = 0;
@@ -38,12 +71,22 @@ struct TypedProperty : PropertyBase {
     T Owner::* MemberPtr;
     
     explicit TypedProperty(const char* InPropertyName, T Owner::* InMemberPtr)
-        : PropertyBase(InPropertyName, TypeTraits<T>::Name(), 
-                       std::is_same_v<T,bool>  ? BasicKind::Bool  :
-                       std::is_same_v<T,int>   ? BasicKind::Int   :
-                                                 BasicKind::Float),
+        : PropertyBase(InPropertyName, TypeTraits<T>::Name(), TypeTraits<T>::Kind, StorageKind()),
           MemberPtr(InMemberPtr)
-    {}
+    {
+        if constexpr (CountedEnum<T>) {
+            const auto Count = static_cast<std::underlying_type_t<T>>(T::Count);
+            uint8_t Bits = 1;
+            while (Bits < 32 && (uint64_t(1) << Bits) < static_cast<uint64_t>(Count)) ++Bits;
+            Meta = PropertyMeta::WithBits(0.0, static_cast<double>(Count > 0 ? Count - 1 : 0), Bits);
+        }
+    }
+
+    static constexpr BasicKind StorageKind()
+    {
+        if constexpr (std::is_enum_v<T>) return IntegerKindOf<std::underlying_type_t<T>>();
+        else return TypeTraits<T>::Kind;
+    }
 
     void* Ptr(void* Obj) const override
     {
@@ -55,6 +98,8 @@ struct TypedProperty : PropertyBase {
         return &(static_cast<const Owner*>(Obj)->*MemberPtr);
     }
 
+    std::size_t ValueSize() const override { return sizeof(T); }
+
     std::string GetAsString(const void* Obj) const override {
         const T& v = *static_cast<const T*>(ConstPtr(Obj));
         return ToString(v);
@@ -86,11 +131,12 @@ struct TypedStructProperty : PropertyBase {
     const StructInfo* SI;
 
     explicit TypedStructProperty(const char* InPropertyName, T Owner::* InMemberPtr)
-        : PropertyBase(InPropertyName, T::StaticStruct().Name, BasicKind::Struct),
+        : PropertyBase(InPropertyName, T::StaticStruct().Name, BasicKind::Struct, BasicKind::Struct),
           MemberPtr(InMemberPtr), SI(&T::StaticStruct()) {}
 
     void* Ptr(void* Obj) const override { return &(static_cast<Owner*>(Obj)->*MemberPtr); }
     const void* ConstPtr(const void* Obj) const override { return &(static_cast<const Owner*>(Obj)->*MemberPtr); }
+    std::size_t ValueSize() const override { return sizeof(T); }
 
     //  doesn't change struct to literal string. (only use leaf)
     std::string GetAsString(const void*) const override { return "<struct>"; }
@@ -112,7 +158,7 @@ inline std::unique_ptr<PropertyBase> MakeProperty(const char* PropertyName, T Ow
     }
     else // T is a primitive or non-supported type
     {
-        static_assert(std::is_same_v<T,bool> || std::is_same_v<T,int>|| std::is_same_v<T,float>, "Only bool/int/float or QSTRUCT are supported.");
+        static_assert(ReflectPrimitive<T>, "Only bool, (u)int8..64, float, double, scoped enums, std::string or QSTRUCT are supported.");
         return std::make_unique<TypedProperty<Owner, T>>(PropertyName, MemberPtr);
     }
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <cassert>
+#include <span>
+#include <string_view>
+#include "ChangeNotify.h"
+#include "TypeInfos.h"
+#include "TypeTraits.h"
+
+class QObject;
+
+// A leaf path ("Position.X", "Level") resolved against a class once.
+// Struct members are stored by value, so the whole offset chain collapses into
+// one byte offset from the object; Get/Set are a pointer add and a typed access.
+class PropertyHandle
+{
+public:
+    PropertyHandle() = default;
+
+    // invalid handle if Path doesn't name a primitive leaf of Info
+    static PropertyHandle Resolve(const ClassInfo& Info, std::string_view Path);
+
+    bool IsValid() const { return Class != nullptr; }
+
+    const ClassInfo* GetClass() const { return Class; }
+    BasicKind        GetKind() const { return Kind; }
+    BasicKind        GetValueKind() const { return ValueKind; }
+    std::size_t      GetOffset() const { return Offset; }
+    std::size_t      GetLeafIndex() const { return LeafIndex; }
+
+    // Obj must be an instance of GetClass() (or a subclass) and T must match GetKind()
+    template <typename T>
+    T Get(const QObject& Obj) const
+    {
+        assert(Class && TypeTraits<T>::Kind == Kind);
+        return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(&Obj) + Offset);
+    }
+
+    // with change notification enabled, only an actual change is written and recorded
+    template <typename T>
+    void Set(QObject& Obj, const T& Value) const
+    {
+        assert(Class && TypeTraits<T>::Kind == Kind);
+        T& Field = *reinterpret_cast<T*>(reinterpret_cast<char*>(&Obj) + Offset);
+        if (!QChangeNotifier::IsEnabled()) { Field = Value; return; }
+        if (Field == Value) return;
+        Field = Value;
+        QChangeNotifier::NotifyChanged(Obj, Offset, sizeof(T));
+    }
+
+    void*       Ptr(QObject& Obj) const { return reinterpret_cast<char*>(&Obj) + Offset; }
+    const void* ConstPtr(const QObject& Obj) const { return reinterpret_cast<const char*>(&Obj) + Offset; }
+
+private:
+    const ClassInfo* Class = nullptr;
+    BasicKind        Kind = BasicKind::Struct;
+    BasicKind        ValueKind = BasicKind::Struct;
+    std::size_t      Offset = 0;
+    std::size_t      LeafIndex = 0;
+};
+
+// A primitive value tagged with its kind, for applying values without knowing T statically.
+struct PropertyValue
+{
+    BasicKind Kind = BasicKind::Bool;
+    union { bool b; float f; double d; int64_t i; }; // every integer kind and enum widens to i
+    std::string s;
+
+    PropertyValue() : i(0) {}
+    PropertyValue(const char* v) : Kind(BasicKind::String), i(0), s(v) {}
+
+    template <typename T>
+    requires ReflectPrimitive<T>
+    PropertyValue(const T& v) : Kind(TypeTraits<T>::Kind), i(0)
+    {
+        if constexpr (std::is_same_v<T, bool>)             b = v;
+        else if constexpr (std::is_same_v<T, float>)       f = v;
+        else if constexpr (std::is_same_v<T, double>)      d = v;
+        else if constexpr (std::is_same_v<T, std::string>) s = v;
+        else if constexpr (std::is_enum_v<T>)              i = static_cast<int64_t>(static_cast<std::underlying_type_t<T>>(v));
+        else                                               i = static_cast<int64_t>(v);
+    }
+};
+
+struct PropertyAssignment
+{
+    PropertyHandle Handle;
+    PropertyValue  Value;
+};
+
+// Apply every assignment to every object. Objects that aren't instances of an
+// assignment's class and values whose kind doesn't match the handle are skipped.
+// Returns the number of writes performed.
+std::size_t ApplyAssignments(std::span<QObject* const> Objects, std::span<const PropertyAssignment> Assignments);
@@ -4,10 +4,41 @@
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include "Property.h"
 
 class QObject;
 
+// A primitive leaf reached by flattening struct properties, e.g. "Position.X".
+struct LeafInfo {
+    std::string         Path;
+    const PropertyBase* Property = nullptr;
+    BasicKind           Kind;
+    BasicKind           ValueKind;  // storage kind, the underlying integer kind for enums
+    std::size_t         Offset = 0; // byte offset from the QObject address
+    std::size_t         Size = 0;
+    PropertyMeta        Meta;       // own meta, or the one of the enclosing struct property
+
+    void*       Ptr(QObject& Obj) const { return reinterpret_cast<char*>(&Obj) + Offset; }
+    const void* ConstPtr(const QObject& Obj) const { return reinterpret_cast<const char*>(&Obj) + Offset; }
+};
+
+// A byte range copied with one memcpy when duplicating an object,
+// or a single std::string leaf that has to be assigned.
+struct CopyRun {
+    std::size_t Offset = 0;
+    std::size_t Size = 0;
+    bool        bString = false;
+};
+
+// 64-bit FNV-1a; pass the previous result as Hash to continue over several buffers
+inline uint64_t Fnv1a64(const void* Data, std::size_t Size, uint64_t Hash = 14695981039346656037ull)
+{
+    const auto* Bytes = static_cast<const unsigned char*>(Data);
+    for (std::size_t i = 0; i < Size; ++i) { Hash ^= Bytes[i]; Hash *= 1099511628211ull; }
+    return Hash;
+}
+
 struct ClassInfo {
     std::string Name;
     ClassInfo*  Base = nullptr;
@@ -21,6 +52,33 @@ struct ClassInfo {
         if (Base) Base->ForEachProperty(Func);
         for (auto& Property : Properties) Func(*Property);
     }
+
+    bool IsChildOf(const ClassInfo& Other) const {
+        for (const ClassInfo* It = this; It; It = It->Base) if (It == &Other) return true;
+        return false;
+    }
+
+    // Flattened leaves in declaration order (base class first).
+    // Offsets are measured once on a Factory instance; empty for classes without a Factory.
+    const std::vector<LeafInfo>& GetLeaves() const;
+
+    // Leaves sorted by offset, with byte-adjacent trivially copyable leaves merged into runs.
+    // String leaves stay separate runs (bString).
+    const std::vector<CopyRun>& GetCopyPlan() const;
+
+    // Hash of the class name and every leaf's path and type, in leaf order. Changes whenever
+    // a reflected field is added, removed, renamed, retyped or reordered.
+    uint64_t GetSchemaHash() const;
+
+private:
+    mutable std::once_flag        LeavesOnce;
+    mutable std::vector<LeafInfo> Leaves;
+
+    mutable std::once_flag        CopyPlanOnce;
+    mutable std::vector<CopyRun>  CopyPlan;
+
+    mutable std::once_flag        SchemaHashOnce;
+    mutable uint64_t              SchemaHash = 0;
 };
 
 struct Registry {
@@ -1,22 +1,181 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <locale>
+#include <type_traits>
 
-enum class BasicKind : std::uint8_t { Bool, Int, Float, Struct };
+// Bool/Int/Float/Struct keep their original values; Int is int32.
+enum class BasicKind : std::uint8_t { Bool, Int, Float, Struct, Int8, Int16, Int64, UInt8, UInt16, UInt32, UInt64, Double, Enum, String };
 
 template <typename T> struct TypeTraits;
-template <> struct TypeTraits<bool>  { static constexpr BasicKind Kind = BasicKind::Bool;  static const char* Name(){ return "bool";  } };
-template <> struct TypeTraits<int>   { static constexpr BasicKind Kind = BasicKind::Int;   static const char* Name(){ return "int";   } };
-template <> struct TypeTraits<float> { static constexpr BasicKind Kind = BasicKind::Float; static const char* Name(){ return "float"; } };
+template <> struct TypeTraits<bool>        { static constexpr BasicKind Kind = BasicKind::Bool;   static const char* Name(){ return "bool";   } };
+template <> struct TypeTraits<int>         { static constexpr BasicKind Kind = BasicKind::Int;    static const char* Name(){ return "int";    } };
+template <> struct TypeTraits<float>       { static constexpr BasicKind Kind = BasicKind::Float;  static const char* Name(){ return "float";  } };
+template <> struct TypeTraits<int8_t>      { static constexpr BasicKind Kind = BasicKind::Int8;   static const char* Name(){ return "int8";   } };
+template <> struct TypeTraits<int16_t>     { static constexpr BasicKind Kind = BasicKind::Int16;  static const char* Name(){ return "int16";  } };
+template <> struct TypeTraits<int64_t>     { static constexpr BasicKind Kind = BasicKind::Int64;  static const char* Name(){ return "int64";  } };
+template <> struct TypeTraits<uint8_t>     { static constexpr BasicKind Kind = BasicKind::UInt8;  static const char* Name(){ return "uint8";  } };
+template <> struct TypeTraits<uint16_t>    { static constexpr BasicKind Kind = BasicKind::UInt16; static const char* Name(){ return "uint16"; } };
+template <> struct TypeTraits<uint32_t>    { static constexpr BasicKind Kind = BasicKind::UInt32; static const char* Name(){ return "uint32"; } };
+template <> struct TypeTraits<uint64_t>    { static constexpr BasicKind Kind = BasicKind::UInt64; static const char* Name(){ return "uint64"; } };
+template <> struct TypeTraits<double>      { static constexpr BasicKind Kind = BasicKind::Double; static const char* Name(){ return "double"; } };
+template <> struct TypeTraits<std::string> { static constexpr BasicKind Kind = BasicKind::String; static const char* Name(){ return "string"; } };
+
+// std::is_scoped_enum_v is C++23; a scoped enum is one that doesn't convert to its underlying type
+template <typename T>
+concept ScopedEnum = std::is_enum_v<T> && !std::is_convertible_v<T, std::underlying_type_t<T>>;
+
+// Spelled name of an enum type ("EMonsterRank", "Game::EState"), taken from the compiler's
+// function signature since the language has no way to ask for it.
+template <typename T>
+std::string_view EnumTypeName()
+{
+#if defined(_MSC_VER)
+    // "... __cdecl EnumTypeName<enum EMonsterRank>(void)"
+    std::string_view Sig = __FUNCSIG__;
+    Sig = Sig.substr(Sig.find("EnumTypeName<") + 13);
+    Sig = Sig.substr(0, Sig.rfind(">("));
+    for (std::string_view Tag : { "enum class ", "enum struct ", "enum " })
+        if (Sig.starts_with(Tag)) { Sig.remove_prefix(Tag.size()); break; }
+    return Sig;
+#else
+    // "... EnumTypeName() [with T = EMonsterRank; ...]" (gcc) or "... [T = EMonsterRank]" (clang)
+    std::string_view Sig = __PRETTY_FUNCTION__;
+    Sig = Sig.substr(Sig.find("T = ") + 4);
+    return Sig.substr(0, Sig.find_first_of(";]"));
+#endif
+}
+
+// scoped enums are stored as their underlying integer; the type name keeps the text
+// format from loading one enum's value into a field of another
+template <typename T>
+requires ScopedEnum<T>
+struct TypeTraits<T>
+{
+    static constexpr BasicKind Kind = BasicKind::Enum;
+    static const char* Name(){ static const std::string Cached(EnumTypeName<T>()); return Cached.c_str(); }
+};
+
+template <typename T>
+concept ReflectPrimitive = requires { TypeTraits<T>::Kind; };
+
+// An enum declaring a trailing `Count` enumerator gets a range of [0, Count) for bit-packing.
+template <typename T>
+concept CountedEnum = ScopedEnum<T> && requires { T::Count; };
+
+#pragma region Kind helpers
+
+inline bool IsSignedIntegerKind(BasicKind Kind)
+{
+    return Kind == BasicKind::Int || Kind == BasicKind::Int8 || Kind == BasicKind::Int16 || Kind == BasicKind::Int64;
+}
+
+inline bool IsUnsignedIntegerKind(BasicKind Kind)
+{
+    return Kind == BasicKind::UInt8 || Kind == BasicKind::UInt16 || Kind == BasicKind::UInt32 || Kind == BasicKind::UInt64;
+}
+
+inline bool IsIntegerKind(BasicKind Kind) { return IsSignedIntegerKind(Kind) || IsUnsignedIntegerKind(Kind); }
+
+// byte size of a primitive kind as stored in memory (0 for Struct/String/Enum, whose size depends on the type)
+inline std::size_t KindSize(BasicKind Kind)
+{
+    switch (Kind) {
+    case BasicKind::Bool:   case BasicKind::Int8:  case BasicKind::UInt8:  return 1;
+    case BasicKind::Int16:  case BasicKind::UInt16:                        return 2;
+    case BasicKind::Int:    case BasicKind::UInt32: case BasicKind::Float: return 4;
+    case BasicKind::Int64:  case BasicKind::UInt64: case BasicKind::Double: return 8;
+    default: return 0;
+    }
+}
+
+// integer kind with the same size and signedness as T (used for enum storage)
+template <typename T>
+constexpr BasicKind IntegerKindOf()
+{
+    if constexpr (std::is_signed_v<T>) {
+        return sizeof(T) == 1 ? BasicKind::Int8 : sizeof(T) == 2 ? BasicKind::Int16 : sizeof(T) == 4 ? BasicKind::Int : BasicKind::Int64;
+    } else {
+        return sizeof(T) == 1 ? BasicKind::UInt8 : sizeof(T) == 2 ? BasicKind::UInt16 : sizeof(T) == 4 ? BasicKind::UInt32 : BasicKind::UInt64;
+    }
+}
+
+// Integer value at Ptr widened to 64 bits (sign-extended for signed kinds, so an
+// unsigned 64-bit value round-trips through the cast).
+inline int64_t LoadInteger(const void* Ptr, BasicKind IntegerKind)
+{
+    switch (IntegerKind) {
+    case BasicKind::Int8:   { int8_t   v; std::memcpy(&v, Ptr, 1); return v; }
+    case BasicKind::Int16:  { int16_t  v; std::memcpy(&v, Ptr, 2); return v; }
+    case BasicKind::Int:    { int32_t  v; std::memcpy(&v, Ptr, 4); return v; }
+    case BasicKind::Int64:  { int64_t  v; std::memcpy(&v, Ptr, 8); return v; }
+    case BasicKind::UInt8:  { uint8_t  v; std::memcpy(&v, Ptr, 1); return v; }
+    case BasicKind::UInt16: { uint16_t v; std::memcpy(&v, Ptr, 2); return v; }
+    case BasicKind::UInt32: { uint32_t v; std::memcpy(&v, Ptr, 4); return v; }
+    case BasicKind::UInt64: { uint64_t v; std::memcpy(&v, Ptr, 8); return static_cast<int64_t>(v); }
+    default: return 0;
+    }
+}
+
+// store Value truncated to the width of IntegerKind
+inline void StoreInteger(void* Ptr, BasicKind IntegerKind, int64_t Value)
+{
+    switch (IntegerKind) {
+    case BasicKind::Int8:   case BasicKind::UInt8:  { uint8_t  v = static_cast<uint8_t>(Value);  std::memcpy(Ptr, &v, 1); } break;
+    case BasicKind::Int16:  case BasicKind::UInt16: { uint16_t v = static_cast<uint16_t>(Value); std::memcpy(Ptr, &v, 2); } break;
+    case BasicKind::Int:    case BasicKind::UInt32: { uint32_t v = static_cast<uint32_t>(Value); std::memcpy(Ptr, &v, 4); } break;
+    case BasicKind::Int64:  case BasicKind::UInt64: { std::memcpy(Ptr, &Value, 8); } break;
+    default: break;
+    }
+}
+
+inline uint64_t ZigZagEncode(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+inline int64_t  ZigZagDecode(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+#pragma endregion
 
 inline std::string ToString(bool v)  { return v ? "true" : "false"; }
 inline std::string ToString(int v)   { return std::to_string(v); }
 inline std::string ToString(float v) { std::ostringstream Oss; Oss.imbue(std::locale::classic()); Oss << v; return Oss.str(); }
 
+inline std::string ToString(int8_t v)   { return std::to_string(static_cast<int>(v)); }
+inline std::string ToString(int16_t v)  { return std::to_string(v); }
+inline std::string ToString(int64_t v)  { return std::to_string(v); }
+inline std::string ToString(uint8_t v)  { return std::to_string(static_cast<unsigned>(v)); }
+inline std::string ToString(uint16_t v) { return std::to_string(v); }
+inline std::string ToString(uint32_t v) { return std::to_string(v); }
+inline std::string ToString(uint64_t v) { return std::to_string(v); }
+inline std::string ToString(double v)
+{
+    std::ostringstream Oss; Oss.imbue(std::locale::classic());
+    Oss.precision(std::numeric_limits<double>::max_digits10);
+    Oss << v; return Oss.str();
+}
+
+// quoted, with \", \\ and \n escaped so the value survives the line-based text format
+inline std::string ToString(const std::string& v)
+{
+    std::string Out = "\"";
+    for (char c : v) {
+        if (c == '"' || c == '\\') { Out += '\\'; Out += c; }
+        else if (c == '\n') Out += "\\n";
+        else if (c == '\r') Out += "\\r";
+        else Out += c;
+    }
+    return Out + "\"";
+}
+
+template <typename T>
+requires ScopedEnum<T>
+inline std::string ToString(T v) { return std::to_string(static_cast<std::underlying_type_t<T>>(v)); }
+
 inline bool FromString(const std::string& s, bool& Out) {
     std::string t = s; std::ranges::transform(t, t.begin(), ::tolower);
     if (t=="true" || t=="1")  { Out = true;  return true; }
@@ -26,3 +185,49 @@ inline bool FromString(const std::string& s, bool& Out) {
 inline bool FromString(const std::string& s, int& Out)   { try { Out = std::stoi(s); return true; } catch(...) { return false; } }
 inline bool FromString(const std::string& s, float& Out) { try { Out = std::stof(s); return true; } catch(...) { return false; } }
 
+// range-checked integer parsing for the fixed-width kinds
+template <typename T>
+requires (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, int>)
+inline bool FromString(const std::string& s, T& Out)
+{
+    const char* Begin = s.data();
+    const char* End = s.data() + s.size();
+    if (Begin != End && *Begin == '+') ++Begin;
+    T v{};
+    auto [Ptr, Ec] = std::from_chars(Begin, End, v);
+    if (Ec != std::errc() || Ptr != End) return false;
+    Out = v; return true;
+}
+
+inline bool FromString(const std::string& s, double& Out)
+{
+    std::istringstream Iss(s); Iss.imbue(std::locale::classic());
+    double v = 0.0;
+    if (!(Iss >> v) || !Iss.eof()) return false;
+    Out = v; return true;
+}
+
+inline bool FromString(const std::string& s, std::string& Out)
+{
+    if (s.size() < 2 || s.front() != '"' || s.back() != '"') return false;
+    std::string v;
+    for (std::size_t i = 1; i + 1 < s.size(); ++i) {
+        char c = s[i];
+        if (c == '\\' && i + 2 < s.size()) {
+            c = s[++i];
+            if (c == 'n') c = '\n';
+            else if (c == 'r') c = '\r';
+        }
+        v += c;
+    }
+    Out = std::move(v); return true;
+}
+
+template <typename T>
+requires ScopedEnum<T>
+inline bool FromString(const std::string& s, T& Out)
+{
+    std::underlying_type_t<T> v{};
+    if (!FromString(s, v)) return false;
+    Out = static_cast<T>(v); return true;
+}
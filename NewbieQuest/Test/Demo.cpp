@@ -1,10 +1,21 @@
 #include "Demo.h"
 
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <random>
 #include "Classes/Monster.h"
+#include "Classes/Player.h"
 #include "CoreMinimal.h"
+#include "Engine/AssetCooker.h"
 #include "Engine/AssetManager.h"
+#include "Engine/AssetStreamer.h"
+#include "Engine/Query.h"
+#include "Engine/SharedAssetCache.h"
+#include "Engine/Snapshot.h"
+#include "Engine/SpatialIndex.h"
+#include "Engine/Trace.h"
 
 namespace Demo
 {
@@ -39,4 +50,598 @@ namespace Demo
         AssetManager.DumpObject(*MonsterFromText, std::cout);
         
     }
+
+    void SnapshotBenchmark()
+    {
+        constexpr int NumMonsters = 100000;
+        constexpr int NumRounds = 20;
+
+        std::mt19937 Rng(1234);
+        std::uniform_real_distribution<float> Coord(-8000.f, 8000.f);
+        std::uniform_real_distribution<float> Unit(0.f, 1.f);
+
+        std::vector<std::unique_ptr<QMonster>> Monsters;
+        std::vector<const QObject*> Objects;
+        for (int i = 0; i < NumMonsters; ++i) {
+            auto Monster = NewObject<QMonster>("Monster_" + std::to_string(i));
+            Monster->SetLevel(i % 60);
+            Monster->SetRage(Unit(Rng));
+            Monster->SetBoss(i % 100 == 0);
+            Monster->GetPosition() = { Coord(Rng), Coord(Rng), Coord(Rng) };
+            Objects.push_back(Monster.get());
+            Monsters.push_back(std::move(Monster));
+        }
+
+        QSnapshotEncoder Encoder;
+        using Clock = std::chrono::steady_clock;
+
+        FBitWriter Writer;
+        auto Start = Clock::now();
+        for (int r = 0; r < NumRounds; ++r) {
+            Writer.Reset();
+            Encoder.EncodeSnapshot(Objects, Writer);
+        }
+        const double FullSeconds = std::chrono::duration<double>(Clock::now() - Start).count();
+        const std::size_t FullBytes = Writer.Finish().size();
+
+        // baseline = decoded snapshot, then move a tenth of the monsters
+        std::vector<std::unique_ptr<QObject>> Baseline;
+        Encoder.DecodeSnapshot(Writer.Finish(), Baseline);
+        std::vector<const QObject*> BaselineObjects;
+        for (auto& Obj : Baseline) BaselineObjects.push_back(Obj.get());
+        for (int i = 0; i < NumMonsters; i += 10) Monsters[i]->GetPosition().X += 1.f;
+
+        FBitWriter DeltaWriter;
+        Start = Clock::now();
+        for (int r = 0; r < NumRounds; ++r) {
+            DeltaWriter.Reset();
+            Encoder.EncodeDelta(BaselineObjects, Objects, DeltaWriter);
+        }
+        const double DeltaSeconds = std::chrono::duration<double>(Clock::now() - Start).count();
+        const std::size_t DeltaBytes = DeltaWriter.Finish().size();
+
+        std::vector<QObject*> Targets;
+        for (auto& Obj : Baseline) Targets.push_back(Obj.get());
+        const bool bApplied = Encoder.ApplyDelta(DeltaWriter.Finish(), Targets);
+
+        std::cout << "\n=== Snapshot Benchmark (" << NumMonsters << " monsters) ===\n";
+        std::cout << "full : " << FullBytes << " bytes, "
+                  << (double(NumMonsters) * NumRounds / FullSeconds / 1e6) << " M objects/s\n";
+        std::cout << "delta: " << DeltaBytes << " bytes, "
+                  << (double(NumMonsters) * NumRounds / DeltaSeconds / 1e6) << " M objects/s, applied="
+                  << (bApplied ? "true" : "false") << "\n";
+        std::cout << "[0] after delta:\n";
+        QAssetManager::Get().DumpObject(*Baseline[0], std::cout);
+    }
+
+    void BufferRoundTrip()
+    {
+        constexpr int NumRounds = 2000;
+        using Clock = std::chrono::steady_clock;
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        auto Monster = NewObject<QMonster>("BufferedOrc");
+        Monster->SetLevel(17);
+        Monster->SetRage(0.25f);
+        Monster->GetPosition() = { 1.f, -2.f, 3.5f };
+
+        auto Same = [&](const QObject* Obj){
+            const QMonster* M = dynamic_cast<const QMonster*>(Obj);
+            return M && M->GetLevel() == Monster->GetLevel() && M->GetRage() == Monster->GetRage()
+                && M->GetPositionRef().X == Monster->GetPositionRef().X && M->GetPositionRef().Z == Monster->GetPositionRef().Z;
+        };
+
+        std::vector<uint8_t> Bytes;
+        int Matches = 0;
+        auto Start = Clock::now();
+        for (int r = 0; r < NumRounds; ++r) {
+            if (AssetManager.SaveToBuffer(*Monster, Bytes) && Same(AssetManager.LoadFromBuffer(Bytes).get())) ++Matches;
+        }
+        const double BufferMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        int FileMatches = 0;
+        Start = Clock::now();
+        for (int r = 0; r < NumRounds; ++r) {
+            if (AssetManager.SaveAsset(*Monster, "Monsters/BufferedOrc") && Same(AssetManager.LoadAssetBinary("Monsters/BufferedOrc").get())) ++FileMatches;
+        }
+        const double FileMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        std::cout << "\n=== Buffer Round Trip (" << NumRounds << " rounds, " << Bytes.size() << " bytes) ===\n";
+        std::cout << "buffer: " << Matches << " matched in " << BufferMs << " ms, file: " << FileMatches
+                  << " matched in " << FileMs << " ms\n";
+    }
+
+    void DuplicateBenchmark()
+    {
+        constexpr std::size_t NumClones = 10000;
+        using Clock = std::chrono::steady_clock;
+
+        auto Archetype = NewObject<QMonster>("OrcBoss");
+        Archetype->SetLevel(35);
+        Archetype->SetRage(0.9f);
+        Archetype->SetBoss(true);
+        Archetype->GetPosition().X = 100.f;
+
+        auto Start = Clock::now();
+        std::vector<std::unique_ptr<QObject>> Clones = DuplicateObjects(*Archetype, NumClones, "OrcBoss");
+        const double CloneSeconds = std::chrono::duration<double>(Clock::now() - Start).count();
+
+        // reference: the same number of object bytes copied into one preallocated block
+        std::vector<char> Bulk(NumClones * sizeof(QMonster));
+        Start = Clock::now();
+        for (std::size_t i = 0; i < NumClones; ++i)
+            std::memcpy(Bulk.data() + i * sizeof(QMonster), static_cast<const void*>(Archetype.get()), sizeof(QMonster));
+        const double MemcpySeconds = std::chrono::duration<double>(Clock::now() - Start).count();
+
+        auto Single = DuplicateObject(*Archetype, "OrcBossCopy");
+
+        std::cout << "\n=== Duplicate Benchmark (" << NumClones << " clones) ===\n";
+        std::cout << "DuplicateObjects: " << CloneSeconds * 1e3 << " ms, memcpy: " << MemcpySeconds * 1e3 << " ms\n";
+        QAssetManager::Get().DumpObject(*Single, std::cout);
+    }
+
+    void AssignByPath()
+    {
+        constexpr int NumMonsters = 10000;
+        constexpr int NumPlayers = 100;
+
+        std::vector<std::unique_ptr<QObject>> Owned;
+        std::vector<QObject*> Objects;
+        for (int i = 0; i < NumMonsters + NumPlayers; ++i) {
+            if (i % 100 == 0) Owned.push_back(NewObject<Player>("Player_" + std::to_string(i)));
+            else              Owned.push_back(NewObject<QMonster>("Monster_" + std::to_string(i)));
+            Objects.push_back(Owned.back().get());
+        }
+
+        const PropertyHandle Level = PropertyHandle::Resolve(QMonster::StaticClass(), "Level");
+        const PropertyHandle PositionX = PropertyHandle::Resolve(QMonster::StaticClass(), "Position.X");
+        const PropertyHandle Ammo = PropertyHandle::Resolve(Player::StaticClass(), "Ammo");
+
+        const PropertyAssignment Assignments[] = {
+            { Level,     PropertyValue(42) },
+            { PositionX, PropertyValue(12.5f) },
+            { Ammo,      PropertyValue(99) },       // only the players match the class
+            { Level,     PropertyValue(1.5f) },     // float into an int leaf: skipped
+        };
+        const std::size_t Writes = ApplyAssignments(Objects, Assignments);
+
+        std::size_t NumMonsterObjects = 0, NumPlayerObjects = 0, Mismatches = 0;
+        for (QObject* Obj : Objects) {
+            if (Obj->GetClassInfo().IsChildOf(QMonster::StaticClass())) {
+                ++NumMonsterObjects;
+                Mismatches += Level.Get<int>(*Obj) != 42 || PositionX.Get<float>(*Obj) != 12.5f;
+            } else {
+                ++NumPlayerObjects;
+                Mismatches += Ammo.Get<int>(*Obj) != 99;
+            }
+        }
+        const std::size_t Expected = NumMonsterObjects * 2 + NumPlayerObjects;
+
+        std::cout << "\n=== Assign By Path (" << NumMonsterObjects << " monsters, " << NumPlayerObjects << " players) ===\n";
+        std::cout << "writes: " << Writes << " (expected " << Expected << "), mismatched values: " << Mismatches << "\n";
+    }
+
+    void TraceAssetOperations()
+    {
+        QAssetManager& AssetManager = QAssetManager::Get();
+        QTrace::SetEnabled(true);
+
+        auto Monster = NewObject<QMonster>("TracedOrc");
+        for (int i = 0; i < 8; ++i) {
+            AssetManager.SaveAsset(*Monster, "Monsters/TracedOrc");
+            AssetManager.LoadAssetBinary("Monsters/TracedOrc");
+        }
+        AssetManager.SaveAssetByText(*Monster, "Monsters/TracedOrc");
+        AssetManager.LoadAssetFromText("Monsters/TracedOrc");
+
+        QTrace::SetEnabled(false);
+        const auto TracePath = AssetManager.EnsureAssetRoot() / "AssetTrace.json";
+        std::cout << "\n=== Trace ===\n" << (QTrace::DumpToFile(TracePath) ? "wrote " : "failed to write ")
+                  << TracePath.string() << "\n";
+    }
+
+    void StreamAssets()
+    {
+        constexpr int NumAssets = 200;
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        for (int i = 0; i < NumAssets; ++i) {
+            auto Monster = NewObject<QMonster>("Streamed_" + std::to_string(i));
+            Monster->SetLevel(i);
+            AssetManager.SaveAsset(*Monster, "Monsters/Streamed_" + std::to_string(i));
+        }
+
+        QAssetStreamer Streamer;
+        int Loaded = 0, Failed = 0;
+        std::vector<FStreamHandle> Handles;
+        for (int i = 0; i < NumAssets; ++i) {
+            Handles.push_back(Streamer.RequestLoad("Monsters/Streamed_" + std::to_string(i), i % 4,
+                [&](FStreamHandle, std::unique_ptr<QObject> Obj){ Obj ? ++Loaded : ++Failed; }));
+        }
+        Streamer.SetPriority(Handles.back(), 100);
+        Streamer.Cancel(Handles.front());
+        Streamer.RequestLoad("Monsters/DoesNotExist", 0, [&](FStreamHandle, std::unique_ptr<QObject> Obj){ Obj ? ++Loaded : ++Failed; });
+
+        int Ticks = 0;
+        while (Streamer.GetNumPending() > 0) {
+            Streamer.Tick(std::chrono::milliseconds(2));
+            ++Ticks;
+            if (Streamer.GetNumPending() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::cout << "\n=== Streaming ===\n" << "loaded " << Loaded << ", failed " << Failed
+                  << ", cancelled 1, in " << Ticks << " ticks\n";
+    }
+
+    void SpatialQueries()
+    {
+        constexpr int NumMonsters = 200000;
+        using Clock = std::chrono::steady_clock;
+
+        std::mt19937 Rng(7);
+        std::uniform_real_distribution<float> Coord(-8000.f, 8000.f);
+
+        std::vector<std::unique_ptr<QMonster>> Monsters;
+        std::vector<QObject*> Objects;
+        for (int i = 0; i < NumMonsters; ++i) {
+            auto Monster = NewObject<QMonster>("Monster_" + std::to_string(i));
+            Monster->GetPosition() = { Coord(Rng), Coord(Rng), 0.f };
+            Objects.push_back(Monster.get());
+            Monsters.push_back(std::move(Monster));
+        }
+
+        QSpatialHashGrid Grid(QMonster::StaticClass(), "Position", 100.f);
+        auto Start = Clock::now();
+        Grid.Build(Objects);
+        const double BuildMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        // move a few monsters, then query around the origin
+        for (int i = 0; i < 1000; ++i) {
+            Monsters[i]->GetPosition().X = 0.f;
+            Grid.Update(Monsters[i].get());
+        }
+        std::vector<QObject*> InRadius, Nearest;
+        Grid.QueryRadius({ 0.f, 0.f, 0.f }, 250.f, InRadius);
+        Grid.QueryNearest({ 0.f, 0.f, 0.f }, 5, Nearest);
+
+        std::cout << "\n=== Spatial Index (" << Grid.Size() << " monsters) ===\n";
+        std::cout << "build " << BuildMs << " ms, within 250: " << InRadius.size() << ", nearest: ";
+        for (QObject* Obj : Nearest) std::cout << Obj->GetObjectName() << " ";
+        std::cout << "\n";
+    }
+
+    void RoundTripValueTypes()
+    {
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        auto SourcePlayer = NewObject<Player>("Typed_Player");
+        SourcePlayer->Health = -7;
+        SourcePlayer->AccountId = 0xF000000000000000ull;          // above INT64_MAX
+        SourcePlayer->DisplayName = "Say \"hi\"\nthen leave";
+        auto SourceMonster = NewObject<QMonster>("Typed_Monster");
+        SourceMonster->SetLevel(-3);
+        SourceMonster->SetRank(EMonsterRank::Champion);
+
+        auto SamePlayer = [&](const QObject* Obj){
+            const Player* P = dynamic_cast<const Player*>(Obj);
+            return P && P->Health == SourcePlayer->Health && P->AccountId == SourcePlayer->AccountId
+                && P->DisplayName == SourcePlayer->DisplayName;
+        };
+        auto SameMonster = [&](const QObject* Obj){
+            const QMonster* M = dynamic_cast<const QMonster*>(Obj);
+            return M && M->GetLevel() == SourceMonster->GetLevel() && M->GetRank() == SourceMonster->GetRank();
+        };
+        auto Report = [](const char* Label, bool bPlayer, bool bMonster){
+            std::cout << Label << ": player " << (bPlayer ? "ok" : "MISMATCH") << ", monster " << (bMonster ? "ok" : "MISMATCH") << "\n";
+        };
+
+        std::cout << "\n=== Value Types Round Trip ===\n";
+
+        AssetManager.SaveAsset(*SourcePlayer, "Typed/Player");
+        AssetManager.SaveAsset(*SourceMonster, "Typed/Monster");
+        Report("binary  ", SamePlayer(AssetManager.LoadAssetBinary("Typed/Player").get()),
+                           SameMonster(AssetManager.LoadAssetBinary("Typed/Monster").get()));
+
+        AssetManager.SaveAssetByText(*SourcePlayer, "Typed/Player");
+        AssetManager.SaveAssetByText(*SourceMonster, "Typed/Monster");
+        Report("text    ", SamePlayer(AssetManager.LoadAssetFromText("Typed/Player").get()),
+                           SameMonster(AssetManager.LoadAssetFromText("Typed/Monster").get()));
+
+        const std::vector<const QObject*> Sources{ SourcePlayer.get(), SourceMonster.get() };
+        QSnapshotEncoder Encoder;
+        FBitWriter Writer;
+        Encoder.EncodeSnapshot(Sources, Writer);
+        std::vector<std::unique_ptr<QObject>> Decoded;
+        const bool bDecoded = Encoder.DecodeSnapshot(Writer.Finish(), Decoded) && Decoded.size() == 2;
+        Report("snapshot", bDecoded && SamePlayer(Decoded[0].get()), bDecoded && SameMonster(Decoded[1].get()));
+
+        // delta from default-constructed objects to the sources, applied onto the defaults
+        auto BasePlayer = NewObject<Player>("Typed_Player");
+        auto BaseMonster = NewObject<QMonster>("Typed_Monster");
+        const std::vector<const QObject*> Baseline{ BasePlayer.get(), BaseMonster.get() };
+        const std::vector<QObject*> Targets{ BasePlayer.get(), BaseMonster.get() };
+        FBitWriter DeltaWriter;
+        const bool bDelta = Encoder.EncodeDelta(Baseline, Sources, DeltaWriter) && Encoder.ApplyDelta(DeltaWriter.Finish(), Targets);
+        Report("delta   ", bDelta && SamePlayer(BasePlayer.get()), bDelta && SameMonster(BaseMonster.get()));
+
+        // a v2 file only knows Bool/Int/Float; the newer leaves keep their defaults
+        FMemoryWriter V2;
+        V2.WriteRaw("QASB", 4);
+        V2.Write_Unsigned16(2);
+        V2.Write_Unsigned16(0);
+        V2.WriteStream("Player");
+        V2.WriteStream("Legacy_Player");
+        V2.Write_Unsigned16(2);
+        V2.WriteStream("Health"); V2.Write_Unsigned8(1); V2.Write_Int32(-7);
+        V2.WriteStream("Zoom");   V2.Write_Unsigned8(2); V2.Write_Float32(2.5f);
+        const std::unique_ptr<QObject> Legacy = AssetManager.LoadFromBuffer(V2.GetBytes());
+        const Player* LegacyPlayer = dynamic_cast<const Player*>(Legacy.get());
+        const bool bLegacy = LegacyPlayer && LegacyPlayer->Health == -7 && LegacyPlayer->Zoom == 2.5f
+                          && LegacyPlayer->AccountId == 0 && LegacyPlayer->DisplayName == "Newbie";
+        std::cout << "v2 file : " << (bLegacy ? "ok" : "MISMATCH") << "\n";
+    }
+
+    void QueryMonsters()
+    {
+        constexpr int NumMonsters = 1000000;
+        using Clock = std::chrono::steady_clock;
+
+        std::mt19937 Rng(11);
+        std::uniform_int_distribution<int> Level(1, 5);
+        std::uniform_real_distribution<float> Rage(0.f, 1.f);
+
+        std::vector<std::unique_ptr<QMonster>> Monsters;
+        std::vector<QObject*> Objects;
+        for (int i = 0; i < NumMonsters; ++i) {
+            auto Monster = NewObject<QMonster>("Monster_" + std::to_string(i));
+            Monster->SetLevel(Level(Rng));
+            Monster->SetRage(Rage(Rng));
+            Monster->SetBoss(i % 10 == 0);
+            Objects.push_back(Monster.get());
+            Monsters.push_back(std::move(Monster));
+        }
+
+        QObjectQuery Query(QMonster::StaticClass());
+        Query.Where("bBoss", EQueryOp::Equal, true).Where("Rage", EQueryOp::Greater, 0.8);
+
+        auto Start = Clock::now();
+        const auto ByLevel = Query.GroupBy(Objects, "Level", "Rage");
+        const double QueryMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        Start = Clock::now();
+        // same work as the query: class check on each object, then count/sum/min/max per level
+        std::map<int, FQueryAggregate> Expected;
+        for (const QObject* Object : Objects) {
+            if (!Object || !Object->GetClassInfo().IsChildOf(QMonster::StaticClass())) continue;
+            const QMonster* Monster = static_cast<const QMonster*>(Object);
+            if (!Monster->IsBoss() || !(Monster->GetRage() > 0.8f)) continue;
+            FQueryAggregate& Group = Expected[Monster->GetLevel()];
+            const double Value = Monster->GetRage();
+            ++Group.Count;
+            Group.Sum += Value;
+            Group.Min = std::min(Group.Min, Value);
+            Group.Max = std::max(Group.Max, Value);
+        }
+        const double LoopMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        std::cout << "\n=== Query (" << NumMonsters << " monsters) ===\n";
+        std::cout << "GroupBy " << QueryMs << " ms, hand-written loop " << LoopMs << " ms\n";
+        for (const auto& [Key, Group] : ByLevel) {
+            std::cout << "Level " << Key << ": " << Group.Count << " bosses (expected " << Expected[static_cast<int>(Key)].Count
+                      << "), mean rage " << Group.Mean() << "\n";
+        }
+
+        // account ids above INT64_MAX compare and group as unsigned
+        std::vector<std::unique_ptr<Player>> Players;
+        std::vector<QObject*> PlayerObjects;
+        for (uint64_t i = 0; i < 8; ++i) {
+            auto NewPlayer = NewObject<Player>("Player_" + std::to_string(i));
+            NewPlayer->AccountId = i % 2 ? 0xF000000000000000ull + i % 4 : i;
+            PlayerObjects.push_back(NewPlayer.get());
+            Players.push_back(std::move(NewPlayer));
+        }
+        const std::size_t HighAccounts = QObjectQuery(Player::StaticClass())
+            .Where("AccountId", EQueryOp::Greater, uint64_t(10)).Count(PlayerObjects);
+        const std::size_t NegativeBound = QObjectQuery(Player::StaticClass())
+            .Where("AccountId", EQueryOp::Greater, -1).Count(PlayerObjects);
+        const auto ByAccount = QObjectQuery(Player::StaticClass()).GroupByUnsigned(PlayerObjects, "AccountId", "");
+        std::cout << "AccountId > 10: " << HighAccounts << " players (expected 4), > -1: " << NegativeBound
+                  << " (expected 8), " << ByAccount.size() << " account groups (expected 6), highest "
+                  << std::hex << (ByAccount.empty() ? 0 : ByAccount.rbegin()->first) << std::dec << "\n";
+    }
+
+    void SaveAndLoadWorld()
+    {
+        constexpr int NumMonsters = 300000;
+        using Clock = std::chrono::steady_clock;
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        std::vector<std::unique_ptr<QMonster>> Monsters;
+        std::vector<const QObject*> Objects;
+        for (int i = 0; i < NumMonsters; ++i) {
+            auto Monster = NewObject<QMonster>("Monster_" + std::to_string(i));
+            Monster->SetLevel(i % 60);
+            Monster->GetPosition().X = static_cast<float>(i);
+            Objects.push_back(Monster.get());
+            Monsters.push_back(std::move(Monster));
+        }
+
+        auto Start = Clock::now();
+        const bool bSaved = AssetManager.SaveWorld(Objects, "Worlds/Shard0");
+        const double SaveMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        Start = Clock::now();
+        std::vector<std::unique_ptr<QObject>> Loaded;
+        const bool bLoaded = AssetManager.LoadWorld("Worlds/Shard0", Loaded);
+        const double LoadMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        std::cout << "\n=== World (" << NumMonsters << " monsters) ===\n";
+        std::cout << "save " << (bSaved ? "ok " : "failed ") << SaveMs << " ms, load " << (bLoaded ? "ok " : "failed ")
+                  << LoadMs << " ms, " << Loaded.size() << " objects\n";
+        if (!Loaded.empty()) AssetManager.DumpObject(*Loaded.back(), std::cout);
+    }
+
+    void CookTextAssets()
+    {
+        QAssetManager& AssetManager = QAssetManager::Get();
+        for (int i = 0; i < 50; ++i) {
+            auto Monster = NewObject<QMonster>("Authored_" + std::to_string(i));
+            Monster->SetLevel(i);
+            AssetManager.SaveAssetByText(*Monster, "Authored/Monster_" + std::to_string(i));
+        }
+
+        QAssetCooker Cooker;
+        std::cout << "\n=== Cook ===\n";
+        Cooker.Cook().Print(std::cout);
+        Cooker.Cook().Print(std::cout);
+    }
+
+    void MountedLoads()
+    {
+        constexpr int NumAssets = 200;
+        using Clock = std::chrono::steady_clock;
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        auto LoadAll = [&]{
+            int Loaded = 0;
+            const auto Start = Clock::now();
+            for (int i = 0; i < NumAssets; ++i)
+                if (AssetManager.LoadAssetBinary("Monsters/Streamed_" + std::to_string(i))) ++Loaded;
+            return std::make_pair(Loaded, std::chrono::duration<double, std::milli>(Clock::now() - Start).count());
+        };
+
+        const auto [ResolvedLoaded, ResolvedMs] = LoadAll();
+        const std::size_t NumMounted = AssetManager.MountAssets();
+        const auto [MountedLoaded, MountedMs] = LoadAll();
+        AssetManager.UnmountAssets();
+
+        std::cout << "\n=== Mounted Loads (" << NumMounted << " assets mounted) ===\n";
+        std::cout << "resolved: " << ResolvedLoaded << " in " << ResolvedMs << " ms, mounted: "
+                  << MountedLoaded << " in " << MountedMs << " ms\n";
+    }
+
+    void ShareAssetsAcrossProcesses()
+    {
+        constexpr int NumAssets = 200;
+        const std::string SegmentName = "/NewbieQuestDemoAssets";
+        using Clock = std::chrono::steady_clock;
+        QAssetManager& AssetManager = QAssetManager::Get();
+
+        // two mappings of one segment stand in for two server processes
+        QSharedAssetCache::Remove(SegmentName);
+        QSharedAssetCache First, Second;
+        if (!First.Open(SegmentName, 1024, 4u << 20) || !Second.Open(SegmentName)) {
+            std::cout << "\n=== Shared Asset Cache === can't open " << SegmentName << "\n";
+            return;
+        }
+
+        auto LoadAll = [&](QSharedAssetCache& Cache){
+            AssetManager.SetSharedCache(&Cache);
+            int Loaded = 0;
+            const auto Start = Clock::now();
+            for (int i = 0; i < NumAssets; ++i)
+                if (AssetManager.LoadAssetBinary("Monsters/Streamed_" + std::to_string(i))) ++Loaded;
+            AssetManager.SetSharedCache(nullptr);
+            return std::make_pair(Loaded, std::chrono::duration<double, std::milli>(Clock::now() - Start).count());
+        };
+
+        const auto [PublishedLoaded, PublishMs] = LoadAll(First);
+        const auto [SharedLoaded, SharedMs] = LoadAll(Second);
+
+        // a rewritten asset misses its stale entry and is published again
+        bool bFresh = false;
+        AssetManager.SetSharedCache(&First);
+        const std::unique_ptr<QObject> Cached = AssetManager.LoadAssetBinary("Monsters/Streamed_0");
+        if (QMonster* Monster = dynamic_cast<QMonster*>(Cached.get())) {
+            const int OldLevel = Monster->GetLevel();
+            Monster->SetLevel(OldLevel + 1);
+            AssetManager.SaveAsset(*Monster, "Monsters/Streamed_0");
+            AssetManager.SetSharedCache(&Second);
+            const std::unique_ptr<QObject> Reloaded = AssetManager.LoadAssetBinary("Monsters/Streamed_0");
+            const QMonster* ReloadedMonster = dynamic_cast<const QMonster*>(Reloaded.get());
+            bFresh = ReloadedMonster && ReloadedMonster->GetLevel() == OldLevel + 1;
+            Monster->SetLevel(OldLevel);
+            AssetManager.SaveAsset(*Monster, "Monsters/Streamed_0");
+        }
+        AssetManager.SetSharedCache(nullptr);
+        const FSharedCacheStats Stats = Second.GetStats();
+
+        std::cout << "\n=== Shared Asset Cache (" << Stats.NumReady << " entries, " << Stats.ArenaUsed
+                  << " of " << Stats.ArenaSize << " arena bytes) ===\n";
+        std::cout << "load + publish: " << PublishedLoaded << " in " << PublishMs << " ms, from shared memory: "
+                  << SharedLoaded << " in " << SharedMs << " ms\n";
+        std::cout << "after a rewrite: " << (bFresh ? "fresh" : "STALE") << "\n";
+        QSharedAssetCache::Remove(SegmentName);
+    }
+
+    void ChangeNotifications()
+    {
+        constexpr int NumMonsters = 100000;
+        constexpr int NumTicks = 20;
+        constexpr int WritesPerTick = 1000;
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<std::unique_ptr<QMonster>> Monsters;
+        auto SpawnMonsters = [&]{
+            Monsters.clear();
+            for (int i = 0; i < NumMonsters; ++i) Monsters.push_back(NewObject<QMonster>("Monster_" + std::to_string(i)));
+        };
+        SpawnMonsters();
+
+        QChangeNotifier& Notifier = QChangeNotifier::Get();
+        std::size_t Replicated = 0, RageUpdates = 0;
+        const uint64_t Replication = Notifier.Subscribe(QMonster::StaticClass(), [&](const FClassChanges& Changes){
+            for (const FLeafChanges& Leaf : Changes.Leaves) Replicated += Leaf.Objects.size();
+        });
+        const uint64_t RageBar = Notifier.Subscribe(QMonster::StaticClass(), "Rage", [&](const ClassInfo&, std::span<QObject* const> Objects){
+            RageUpdates += Objects.size();
+        });
+
+        constexpr unsigned Seed = 5;
+        std::mt19937 Rng(Seed);
+        std::uniform_int_distribution<int> Pick(0, NumMonsters - 1);
+        const PropertyHandle PositionX = PropertyHandle::Resolve(QMonster::StaticClass(), "Position.X");
+        auto Tick = [&](int t){
+            for (int w = 0; w < WritesPerTick; ++w) {
+                QMonster& Monster = *Monsters[Pick(Rng)];
+                switch (w % 3) {
+                case 0:  Monster.SetRage(static_cast<float>(t + 1) / NumTicks); break;
+                case 1:  Monster.SetLevel(Monster.GetLevel() + 1); break;
+                default: PositionX.Set(Monster, static_cast<float>(t)); break;
+                }
+            }
+        };
+
+        auto Start = Clock::now();
+        std::size_t Flushed = 0;
+        for (int t = 0; t < NumTicks; ++t) { Tick(t); Flushed += Notifier.Flush(); }
+        const double NotifyMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+        Notifier.Unsubscribe(Replication);
+        Notifier.Unsubscribe(RageBar);
+
+        // what each system did before: keep a copy and diff every monster every tick.
+        // Fresh monsters and the same writes as the notified pass.
+        SpawnMonsters();
+        Rng.seed(Seed);
+        Pick.reset();
+        struct FPolled { int Level; float Rage; float X; };
+        std::vector<FPolled> Previous;
+        for (const auto& Monster : Monsters) Previous.push_back({ Monster->GetLevel(), Monster->GetRage(), Monster->GetPositionRef().X });
+        std::size_t Polled = 0;
+        Start = Clock::now();
+        for (int t = 0; t < NumTicks; ++t) {
+            Tick(t);
+            for (std::size_t i = 0; i < Monsters.size(); ++i) {
+                const QMonster& Monster = *Monsters[i];
+                FPolled Now{ Monster.GetLevel(), Monster.GetRage(), Monster.GetPositionRef().X };
+                Polled += (Now.Level != Previous[i].Level) + (Now.Rage != Previous[i].Rage) + (Now.X != Previous[i].X);
+                Previous[i] = Now;
+            }
+        }
+        const double PollMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        std::cout << "\n=== Change Notifications (" << NumMonsters << " monsters, " << NumTicks << " ticks) ===\n";
+        std::cout << "notify + flush: " << Flushed << " changes (" << Replicated << " replicated, " << RageUpdates
+                  << " rage updates) in " << NotifyMs << " ms; polling: " << Polled << " changes in " << PollMs << " ms\n";
+    }
 }
@@ -3,5 +3,47 @@
 namespace Demo
 {
     void Case1();
+
+    // bit-packed snapshot size and encode throughput
+    void SnapshotBenchmark();
+
+    // SaveToBuffer / LoadFromBuffer round trip vs SaveAsset / LoadAssetBinary through a file
+    void BufferRoundTrip();
+
+    // DuplicateObjects vs a plain memcpy of the same bytes
+    void DuplicateBenchmark();
+
+    // Level / Position.X / Ammo set by path over mixed monsters and players, checked with PropertyHandle::Get
+    void AssignByPath();
+
+    // asset save/load timeline written as Chrome trace-event JSON
+    void TraceAssetOperations();
+
+    // prioritized loads finished over several 2 ms ticks
+    void StreamAssets();
+
+    // parallel grid build and radius / k-nearest queries over monster positions
+    void SpatialQueries();
+
+    // uint64 above INT64_MAX, a quoted multi-line string and an enum through binary, text, snapshot, delta and a v2 file
+    void RoundTripValueTypes();
+
+    // "bosses with Rage > 0.8, grouped by Level" through QObjectQuery vs a hand-written loop
+    void QueryMonsters();
+
+    // 300k monsters through one .qworld file
+    void SaveAndLoadWorld();
+
+    // cook text assets to binary twice; the second pass skips everything via the manifest
+    void CookTextAssets();
+
+    // the streamed assets loaded by name, resolving paths on disk vs through the mounted manifest
+    void MountedLoads();
+
+    // the streamed assets loaded once and published to shared memory, then built from it by a second mapping
+    void ShareAssetsAcrossProcesses();
+
+    // random setter and handle writes per tick, delivered through QChangeNotifier vs diffing every monster
+    void ChangeNotifications();
     
 }
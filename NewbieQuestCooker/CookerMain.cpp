@@ -0,0 +1,39 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "Classes/Actor.h"
+#include "Classes/Monster.h"
+#include "Classes/Player.h"
+#include "Engine/AssetCooker.h"
+#include "Engine/AssetManager.h"
+
+// Converts every .qasset_t under the asset root into binary .qasset.
+// usage: NewbieQuestCooker [AssetRoot] [-threads N] [-force]
+int main(int argc, char** argv)
+{
+    unsigned NumThreads = 0;
+    bool bForce = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string Arg = argv[i];
+        if (Arg == "-force") {
+            bForce = true;
+        } else if (Arg == "-threads" && i + 1 < argc) {
+            NumThreads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!Arg.empty() && Arg[0] != '-') {
+            QAssetManager::Get().SetAssetRoot(Arg);
+        } else {
+            std::cerr << "usage: NewbieQuestCooker [AssetRoot] [-threads N] [-force]\n";
+            return 2;
+        }
+    }
+
+    // classes register on their first StaticClass() call
+    Actor::StaticClass();
+    Player::StaticClass();
+    QMonster::StaticClass();
+
+    QAssetCooker Cooker;
+    const FCookReport Report = Cooker.Cook(NumThreads, bForce);
+    Report.Print(std::cout);
+    return Report.Errors.empty() ? 0 : 1;
+}